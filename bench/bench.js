@@ -0,0 +1,171 @@
+#!/usr/bin/env node
+// Benchmarks of the JS <-> C++ binding layer.
+//
+// Needs an addon built for node, along with the bench addon:
+//
+//     LIBSESSION_RUNTIME=node LIBSESSION_RUNTIME_VERSION=$(node -p process.versions.node) \
+//         LIBSESSION_NODEJS_BENCH=1 pnpm install
+//     pnpm bench [--json] [--end-to-end] [--addon <checkout>]
+//
+// The conversion microbenchmarks are timed natively by build/Release/libsession_util_nodejs_bench
+// (see bench/bench_addon.cpp); merge/push/dump are timed end-to-end, from JS, on synthetic contacts
+// configs.  With --json, the results are printed as a single JSON object for CI to pick up.
+//
+// With --end-to-end, only the end-to-end benchmarks are run: they only need the addon itself, so
+// they can also be run against the build of another checkout (--addon), e.g. one from before a
+// change, to measure it:
+//
+//     node bench/bench.js --json --end-to-end --addon ../before > before.json
+//     node bench/bench.js --json --end-to-end > after.json
+//     node bench/compare.js before.json after.json
+//
+// Benchmarks of methods that addon does not have are skipped (reported as null).
+
+const crypto = require('crypto');
+const path = require('path');
+
+function option(name) {
+  const i = process.argv.indexOf(name);
+  return i >= 0 ? process.argv[i + 1] : undefined;
+}
+
+const json = process.argv.includes('--json');
+const endToEndOnly = process.argv.includes('--end-to-end');
+const addon = path.resolve(option('--addon') ?? path.join(__dirname, '..'));
+
+const { ContactsConfigWrapperNode } = require(addon);
+
+const SIZES = [10, 1000, 10000];
+const MIN_DURATION_MS = 200;
+
+const results = {};
+
+function report(name, nsPerOp) {
+  results[name] = nsPerOp;
+  if (!json) {
+    console.log(`${name.padEnd(52)} ${(nsPerOp / 1000).toFixed(3).padStart(14)} µs/op`);
+  }
+}
+
+// Calls `native[fn](...args, iterations)` with growing iteration counts until one run lasts at
+// least MIN_DURATION_MS, and reports its ns/iteration.
+function benchNative(name, fn, ...args) {
+  const native = require(path.join(addon, 'build/Release/libsession_util_nodejs_bench.node'));
+  for (let iterations = 1; ; iterations *= 4) {
+    const nsPerOp = native[fn](...args, iterations);
+    if (nsPerOp * iterations >= MIN_DURATION_MS * 1e6) {
+      report(name, nsPerOp);
+      return;
+    }
+  }
+}
+
+// Times `fn(setup())` until MIN_DURATION_MS worth of `fn` calls have run; `setup` isn't timed.
+function benchJs(name, fn, setup = () => undefined) {
+  try {
+    fn(setup());
+  } catch (e) {
+    // e.g. a method added after the addon being benchmarked was built
+    results[name] = null;
+    console.error(`${name}: skipped (${e.message})`);
+    return;
+  }
+
+  let total = 0n;
+  let iterations = 0;
+  while (total < BigInt(MIN_DURATION_MS * 1e6)) {
+    const arg = setup();
+    const start = process.hrtime.bigint();
+    fn(arg);
+    total += process.hrtime.bigint() - start;
+    iterations++;
+  }
+  report(name, Number(total) / iterations);
+}
+
+function fakeSessionId(i) {
+  return `05${i.toString(16).padStart(64, '0')}`;
+}
+
+function makeSecretKey() {
+  const { privateKey, publicKey } = crypto.generateKeyPairSync('ed25519');
+  const seed = Buffer.from(privateKey.export({ format: 'jwk' }).d, 'base64url');
+  const pubkey = Buffer.from(publicKey.export({ format: 'jwk' }).x, 'base64url');
+  return new Uint8Array(Buffer.concat([seed, pubkey]));
+}
+
+function makeContacts(secretKey, count) {
+  const wrapper = new ContactsConfigWrapperNode(secretKey, null);
+  for (let i = 0; i < count; i++) {
+    wrapper.set({
+      id: fakeSessionId(i),
+      name: `contact ${i}`,
+      nickname: i % 3 === 0 ? `nick ${i}` : undefined,
+      approved: true,
+      approvedMe: true,
+      blocked: false,
+      priority: 0,
+      createdAtSeconds: 1700000000 + i,
+      profileUpdatedSeconds: 1700000000 + i,
+      expirationMode: 'off',
+      expirationTimerSeconds: 0,
+    });
+  }
+  return wrapper;
+}
+
+function conversions() {
+  for (const size of [32, 1024, 65536]) {
+    const buf = crypto.randomBytes(size);
+    benchNative(`toCppBuffer (${size} B)`, 'toCppBuffer', buf);
+  }
+  for (const length of [66, 4096]) {
+    benchNative(`toCppString (${length} chars)`, 'toCppString', 'x'.repeat(length));
+  }
+  for (const count of SIZES) {
+    benchNative(`toJs vector<string> (${count})`, 'toJsStringVector', count);
+    benchNative(`toJs vector<vector<uchar>> (${count})`, 'toJsBufferVector', count, 256);
+    benchNative(`member_to_js (${count})`, 'memberToJs', count);
+    benchNative(`toJs contact_info (${count})`, 'contactToJs', count);
+    benchNative(`contact-shaped objects, C string keys (${count})`, 'propertyKeys', count, false);
+    benchNative(`contact-shaped objects, interned keys (${count})`, 'propertyKeys', count, true);
+  }
+}
+
+function endToEnd() {
+  const secretKey = makeSecretKey();
+  for (const count of SIZES) {
+    const source = makeContacts(secretKey, count);
+    const pushed = source.push();
+    const toMerge = pushed.data.map((data, i) => ({ hash: `hash${i}`, data }));
+
+    benchJs(`contacts push (${count})`, () => source.push());
+    benchJs(`contacts dump (${count})`, () => source.dump());
+    benchJs(`contacts getAll (${count})`, () => source.getAll());
+    benchJs(`contacts getAll id/name/priority (${count})`, () =>
+      source.getAll(['id', 'name', 'priority']),
+    );
+    benchJs(`contacts getAllColumnar id/name/priority (${count})`, () =>
+      source.getAllColumnar(['id', 'name', 'priority']),
+    );
+    benchJs(
+      `contacts merge (${count})`,
+      target => target.merge(toMerge),
+      () => new ContactsConfigWrapperNode(secretKey, null),
+    );
+    benchJs(
+      `contacts merge with change set (${count})`,
+      target => target.merge(toMerge, { changeSet: true }),
+      () => new ContactsConfigWrapperNode(secretKey, null),
+    );
+  }
+}
+
+if (!endToEndOnly) {
+  conversions();
+}
+endToEnd();
+
+if (json) {
+  console.log(JSON.stringify(results, null, 2));
+}
@@ -0,0 +1,213 @@
+// Microbenchmarks of the JS <-> C++ marshalling layer.
+//
+// Built as a separate addon (libsession_util_nodejs_bench.node, see LIBSESSION_NODEJS_BENCH in
+// CMakeLists.txt) from the same sources as the real one, so that the conversions can be timed in a
+// native loop without the JS call overhead getting in the way.  Driven by bench/bench.js.
+//
+// Every bench function takes the number of iterations as its last argument and returns the mean
+// time of one iteration, in nanoseconds.
+
+#include <napi.h>
+#include <oxenc/hex.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "addon_data.hpp"
+#include "contacts_config.hpp"
+#include "groups/meta_group_wrapper.hpp"
+#include "utilities.hpp"
+
+namespace session::nodeapi::bench {
+
+using config::contact_info;
+
+// Written to by the benchmarked loops so that the compiler cannot drop the work.
+static volatile size_t sink;
+
+template <typename Fn>
+static double ns_per_iteration(int64_t iterations, Fn&& fn) {
+    checkOrThrow(iterations > 0, "iterations must be positive");
+    auto start = std::chrono::steady_clock::now();
+    for (int64_t i = 0; i < iterations; i++)
+        fn();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+// Deterministic, distinct, valid session ids: "05" followed by 64 hex digits.
+static std::string fake_session_id(size_t i) {
+    std::string id = "05" + std::string(64, '0');
+    auto hex = oxenc::to_hex(std::to_string(i));
+    id.replace(id.size() - hex.size(), hex.size(), hex);
+    return id;
+}
+
+// toCppBuffer(buf: Uint8Array, iterations: number)
+static Napi::Value toCppBuffer(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 2);
+        auto buf = info[0];
+        return ns_per_iteration(toCppInteger(info[1], "iterations"), [&] {
+            sink = session::nodeapi::toCppBuffer(buf, "bench").size();
+        });
+    });
+}
+
+// toCppString(str: string, iterations: number)
+static Napi::Value toCppString(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 2);
+        auto str = info[0];
+        return ns_per_iteration(toCppInteger(info[1], "iterations"), [&] {
+            sink = session::nodeapi::toCppString(str, "bench").size();
+        });
+    });
+}
+
+// toJsStringVector(count: number, iterations: number): converts a vector of `count` session ids.
+static Napi::Value toJsStringVector(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 2);
+        auto env = info.Env();
+        std::vector<std::string> vec(toCppInteger(info[0], "count"));
+        for (size_t i = 0; i < vec.size(); i++)
+            vec[i] = fake_session_id(i);
+
+        return ns_per_iteration(toCppInteger(info[1], "iterations"), [&] {
+            Napi::HandleScope scope{env};
+            sink = toJs(env, vec).Length();
+        });
+    });
+}
+
+// toJsBufferVector(count: number, size: number, iterations: number): converts a vector of `count`
+// buffers of `size` bytes each.
+static Napi::Value toJsBufferVector(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 3);
+        auto env = info.Env();
+        std::vector<std::vector<unsigned char>> vec(
+                toCppInteger(info[0], "count"),
+                std::vector<unsigned char>(toCppInteger(info[1], "size"), 0x42));
+
+        return ns_per_iteration(toCppInteger(info[2], "iterations"), [&] {
+            Napi::HandleScope scope{env};
+            sink = toJs(env, vec).Length();
+        });
+    });
+}
+
+// memberToJs(count: number, iterations: number): converts `count` members, as memberGetAll does.
+static Napi::Value memberToJs(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 2);
+        auto env = info.Env();
+        std::vector<member> members;
+        size_t count = toCppInteger(info[0], "count");
+        members.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            auto& m = members.emplace_back(fake_session_id(i));
+            m.set_name_truncated("member " + std::to_string(i));
+        }
+
+        return ns_per_iteration(toCppInteger(info[1], "iterations"), [&] {
+            Napi::HandleScope scope{env};
+            auto result = Napi::Array::New(env, members.size());
+            for (size_t i = 0; i < members.size(); i++)
+                result[i] = member_to_js(env, members[i], member::Status::invite_sent);
+            sink = result.Length();
+        });
+    });
+}
+
+// contactToJs(count: number, iterations: number): converts `count` contacts, as getAll does.
+static Napi::Value contactToJs(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 2);
+        auto env = info.Env();
+        std::vector<contact_info> contacts;
+        size_t count = toCppInteger(info[0], "count");
+        contacts.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            auto& c = contacts.emplace_back(fake_session_id(i));
+            c.set_name("contact " + std::to_string(i));
+            c.approved = true;
+        }
+
+        return ns_per_iteration(toCppInteger(info[1], "iterations"), [&] {
+            Napi::HandleScope scope{env};
+            sink = toJs(env, contacts).Length();
+        });
+    });
+}
+
+// The 13 property names of a contact, as set by toJs_impl<contact_info>.
+static constexpr const char* CONTACT_KEYS[] = {
+        "id",
+        "name",
+        "nickname",
+        "approved",
+        "approvedMe",
+        "profileUpdatedSeconds",
+        "blocked",
+        "priority",
+        "createdAtSeconds",
+        "expirationMode",
+        "expirationTimerSeconds",
+        "profilePicture",
+        "proProfileBitset"};
+
+// propertyKeys(count: number, interned: boolean, iterations: number): creates `count` objects with
+// the properties of a contact, keyed either by interned strings (AddonData::interned) or, as
+// `obj["name"] = ...` does, by strings created from the C strings for each object.
+static Napi::Value propertyKeys(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 3);
+        auto env = info.Env();
+        size_t count = toCppInteger(info[0], "count");
+        bool use_interned = toCppBoolean(info[1], "interned");
+        auto& addon = AddonData::get(env);
+        auto value = Napi::Number::New(env, 42);
+
+        return ns_per_iteration(toCppInteger(info[2], "iterations"), [&] {
+            Napi::HandleScope scope{env};
+            auto result = Napi::Array::New(env, count);
+            for (size_t i = 0; i < count; i++) {
+                auto obj = Napi::Object::New(env);
+                for (const char* k : CONTACT_KEYS) {
+                    if (use_interned)
+                        obj.Set(addon.interned(k), value);
+                    else
+                        obj[k] = value;
+                }
+                result[i] = obj;
+            }
+            sink = result.Length();
+        });
+    });
+}
+
+}  // namespace session::nodeapi::bench
+
+Napi::Object InitBench(Napi::Env env, Napi::Object exports) {
+    namespace bench = session::nodeapi::bench;
+    using bench_fn = Napi::Value (*)(const Napi::CallbackInfo&);
+    std::pair<const char*, bench_fn> benches[] = {
+            {"toCppBuffer", bench::toCppBuffer},
+            {"toCppString", bench::toCppString},
+            {"toJsStringVector", bench::toJsStringVector},
+            {"toJsBufferVector", bench::toJsBufferVector},
+            {"memberToJs", bench::memberToJs},
+            {"contactToJs", bench::contactToJs},
+            {"propertyKeys", bench::propertyKeys},
+    };
+    for (auto [name, fn] : benches)
+        exports[name] = Napi::Function::New(env, fn, name);
+    return exports;
+}
+
+NODE_API_MODULE(libsession_util_nodejs_bench, InitBench);
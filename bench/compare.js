@@ -0,0 +1,29 @@
+#!/usr/bin/env node
+// Compares two sets of results of `bench.js --json` (e.g. from before and after a change, see
+// bench.js), as a markdown table of their common benchmarks:
+//
+//     node bench/compare.js before.json after.json
+
+const fs = require('fs');
+
+const [beforeFile, afterFile] = process.argv.slice(2);
+if (!beforeFile || !afterFile) {
+  console.error('usage: compare.js <before.json> <after.json>');
+  process.exit(1);
+}
+
+const before = JSON.parse(fs.readFileSync(beforeFile, 'utf8'));
+const after = JSON.parse(fs.readFileSync(afterFile, 'utf8'));
+
+const us = ns => (ns == null ? 'n/a' : (ns / 1000).toFixed(3));
+
+console.log('| benchmark | before (µs/op) | after (µs/op) | change |');
+console.log('| --- | ---: | ---: | ---: |');
+for (const [name, ns] of Object.entries(after)) {
+  if (!(name in before)) {
+    continue;
+  }
+  const old = before[name];
+  const change = old == null || ns == null ? 'n/a' : `${(((ns - old) / old) * 100).toFixed(1)}%`;
+  console.log(`| ${name} | ${us(old)} | ${us(ns)} | ${change} |`);
+}
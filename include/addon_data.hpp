@@ -0,0 +1,46 @@
+#pragma once
+
+#include <napi.h>
+
+#include <string>
+#include <unordered_map>
+
+namespace session::nodeapi {
+
+/// Per-env state of the addon, stored as the env's instance data: every Worker (or other context)
+/// loading the addon gets its own.  Must only be used from the thread of its env.
+class AddonData {
+  public:
+    // Returns the AddonData of `env`, creating it on first use.  The env deletes it when it tears
+    // down.
+    static AddonData& get(Napi::Env env);
+
+    // Keeps a persistent reference to a class constructor registered by one of the Init functions.
+    void add_constructor(const char* class_name, Napi::Function cls);
+
+    // Returns the constructor registered under `class_name`; throws if there is none.
+    Napi::Function constructor(const std::string& class_name) const;
+
+    // Returns the JS string for `literal`, created on first use and then held for the lifetime of
+    // the env.  Meant for property names (and enum-like values) set on every object of a kind:
+    // `obj.Set(addon.interned("name"), ...)` saves creating, and then having V8 internalize, a new
+    // string from the C string for each object, which is what `obj["name"] = ...` does.
+    //
+    // `literal` must be a string literal: entries are keyed by its address, not its contents.
+    Napi::String interned(const char* literal);
+
+  private:
+    explicit AddonData(Napi::Env env) : env_{env} {}
+
+    Napi::Env env_;
+    std::unordered_map<std::string, Napi::FunctionReference> constructors_;
+    std::unordered_map<const char*, Napi::Reference<Napi::String>> interned_;
+};
+
+// Shortcut for AddonData::get(env).interned(literal); when setting several properties, prefer
+// fetching the AddonData once.
+inline Napi::String interned(const Napi::Env& env, const char* literal) {
+    return AddonData::get(env).interned(literal);
+}
+
+}  // namespace session::nodeapi
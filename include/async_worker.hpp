@@ -0,0 +1,118 @@
+#pragma once
+
+#include <napi.h>
+
+#include <exception>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "utilities.hpp"
+
+namespace session::nodeapi {
+
+// Default result converter for PromiseWorker: hands the job result to toJs().
+struct ToJsConverter {
+    template <typename T>
+    Napi::Value operator()(const Napi::Env& env, T&& val) const {
+        return toJs(env, std::forward<T>(val));
+    }
+};
+
+/// An Napi::AsyncWorker that settles a Promise instead of invoking a JS callback.
+///
+/// `Job` is invoked on the libuv threadpool and so must not touch *any* Napi value: everything it
+/// needs has to be copied into plain C++ types before the worker is queued.  Its return value is
+/// moved back to the JS thread and converted with `Convert` (toJs() by default) to resolve the
+/// promise.  A std::exception thrown by the job rejects the promise with an Error carrying the
+/// exception message.
+///
+/// Usage:
+///
+///     auto* worker = makePromiseWorker(env, "Whatever::fooAsync", [data = std::move(data)] {
+///         return do_something_slow(data);
+///     });
+///     worker->OnSettled([this] { busy_ = false; });
+///     worker->KeepAlive(info.This().As<Napi::Object>());
+///     return worker->QueuePromise();
+template <typename Job, typename Convert = ToJsConverter>
+class PromiseWorker : public Napi::AsyncWorker {
+  public:
+    using Result = std::invoke_result_t<Job&>;
+    static_assert(!std::is_void_v<Result>, "PromiseWorker jobs must return a value");
+
+    PromiseWorker(Napi::Env env, const char* resource_name, Job job, Convert convert) :
+            Napi::AsyncWorker{env, resource_name},
+            deferred_{Napi::Promise::Deferred::New(env)},
+            job_{std::move(job)},
+            convert_{std::move(convert)} {}
+
+    // Sets a callback invoked on the JS thread once the job has finished (successfully or not),
+    // just before the promise is settled.  Typically used to release a guard taken when queuing.
+    void OnSettled(std::function<void()> on_settled) { on_settled_ = std::move(on_settled); }
+
+    // Holds a strong reference to `obj` (usually the wrapper the job operates on) until the job
+    // settles so that it cannot be garbage collected while the job is running.
+    void KeepAlive(Napi::Object obj) { keep_alive_ = Napi::Persistent(obj); }
+
+    // Queues the job on the threadpool and returns the promise it will settle.  The worker deletes
+    // itself once settled, so it must not be used after this call.
+    Napi::Promise QueuePromise() {
+        auto promise = deferred_.Promise();
+        Queue();
+        return promise;
+    }
+
+  protected:
+    void Execute() override {
+        try {
+            result_.emplace(job_());
+        } catch (const std::exception& e) {
+            SetError(e.what());
+        } catch (...) {
+            SetError("Unknown exception in async job");
+        }
+    }
+
+    void OnOK() override {
+        settled();
+        auto env = Env();
+        try {
+            deferred_.Resolve(convert_(env, std::move(*result_)));
+        } catch (const Napi::Error& e) {
+            deferred_.Reject(e.Value());
+        } catch (const std::exception& e) {
+            deferred_.Reject(Napi::Error::New(env, e.what()).Value());
+        }
+    }
+
+    void OnError(const Napi::Error& e) override {
+        settled();
+        deferred_.Reject(e.Value());
+    }
+
+  private:
+    void settled() {
+        if (on_settled_)
+            std::exchange(on_settled_, nullptr)();
+        keep_alive_.Reset();
+    }
+
+    Napi::Promise::Deferred deferred_;
+    Job job_;
+    Convert convert_;
+    std::optional<Result> result_;
+    std::function<void()> on_settled_;
+    Napi::ObjectReference keep_alive_;
+};
+
+// Allocates a PromiseWorker (which owns and deletes itself once queued and settled).
+template <typename Job, typename Convert = ToJsConverter>
+PromiseWorker<std::decay_t<Job>, Convert>* makePromiseWorker(
+        Napi::Env env, const char* resource_name, Job&& job, Convert convert = {}) {
+    return new PromiseWorker<std::decay_t<Job>, Convert>{
+            env, resource_name, std::forward<Job>(job), std::move(convert)};
+}
+
+}  // namespace session::nodeapi
@@ -4,17 +4,83 @@
 #include <oxenc/hex.h>
 
 #include <cassert>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <oxen/log.hpp>
 #include <stdexcept>
 #include <unordered_set>
+#include <vector>
 
+#include "async_worker.hpp"
+#include "change_set.hpp"
 #include "session/config/base.hpp"
 #include "utilities.hpp"
 
 namespace session::nodeapi {
 
 class ConfigBaseImpl;
+class MetaUserWrapper;
+
+// Parses the `[{hash, data}, ...]` argument of merge/mergeAsync.  Unless `copy` is set the data
+// borrows the JS buffers, so the result must not outlive the current call.
+merge_entries merge_entries_from_JS(
+        const Napi::Value& val, const std::string& identifier, bool copy);
+
+// The (secret key, optional dump) arguments of the config wrappers' constructors and createAsync(),
+// as owned copies.
+struct config_args {
+    std::vector<unsigned char> secret_key;
+    std::optional<std::vector<unsigned char>> dump;
+};
+
+// Parses the config_args of the call `info`, naming it `identifier` (e.g.
+// "ContactsConfigWrapper.createAsync") in the errors.
+config_args config_args_from_JS(const Napi::CallbackInfo& info, const std::string& identifier);
+
+/// Wrappers can also be constructed around a native object made beforehand, rather than from
+/// their JS arguments: e.g. the config or group that createAsync() loaded on the threadpool, or a
+/// cursor's iterators.  construct_adopting() passes the object to the constructor of the wrapper
+/// class as its single argument, in an External, and the constructor moves it out of adopted().
+/// JS cannot create Externals, so this path cannot be reached from JS.
+template <typename T>
+Napi::Object construct_adopting(const Napi::Function& cls, T&& obj) {
+    return cls.New({Napi::External<std::remove_cvref_t<T>>::New(cls.Env(), &obj)});
+}
+
+// The object the constructor call `info` got from construct_adopting(), or null if it was called
+// with JS arguments.
+template <typename T>
+T* adopted(const Napi::CallbackInfo& info) {
+    if (info.Length() == 1 && info[0].IsExternal())
+        return info[0].As<Napi::External<T>>().Data();
+    return nullptr;
+}
+
+// The class a static method (e.g. createAsync()) was called on, which is its `this`: to construct
+// its instances from there, subclasses included.
+inline Napi::Function called_class(const Napi::CallbackInfo& info) {
+    return info.This().As<Napi::Function>();
+}
+
+// Constructs an instance of the config wrapper class `cls` around the already loaded `conf` (see
+// ConfigBaseImpl::construct).
+inline Napi::Object adopt_config(
+        const Napi::Function& cls, std::shared_ptr<config::ConfigBase> conf) {
+    return construct_adopting(cls, std::move(conf));
+}
+
+// Returns the fingerprints of the entries of each of a config's collections, keyed by collection
+// name, from which merge() and mergeAsync() compute their change sets.  A plain function of the
+// config, rather than of its wrapper, so that mergeAsync() can call it from its job.
+using config_fingerprinter = config_fingerprints (*)(config::ConfigBase& conf);
+
+// The config_fingerprinter of the configs without collections (e.g. the user profile), whose change
+// set is always empty.
+inline config_fingerprints no_collections(config::ConfigBase&) {
+    return {};
+}
+
 template <typename T>
 inline constexpr bool is_derived_napi_wrapper = std::is_base_of_v<Napi::ObjectWrap<T>, T>;
 
@@ -24,9 +90,26 @@ inline constexpr bool is_derived_napi_wrapper = std::is_base_of_v<Napi::ObjectWr
 /// `ConfigBaseImpl::WithBaseMethods<Subtype>({...})` to have the base methods added to the derived
 /// type appropriately.
 class ConfigBaseImpl {
+    // Constructs the user configs itself, and then pushes, dumps and merges them through their
+    // wrappers.
+    friend class MetaUserWrapper;
 
     std::shared_ptr<config::ConfigBase> conf_;
 
+    // The name of the wrapper subclass (its CLASS_NAME), which the instrumentation records the
+    // base methods' calls under.
+    const char* class_name_;
+
+    config_fingerprinter fingerprints_;
+
+    // Set while an async job (e.g. mergeAsync) is operating on `conf_` from the threadpool; any
+    // access through get_config() is refused until the job settles.  Only touched on the JS thread.
+    bool busy_ = false;
+
+    // Bumped by every call that changes, or may change, the config's data (see mutated()), so that
+    // the ConfigCursors iterating over it can detect it.  Only touched on the JS thread.
+    uint64_t mutation_epoch_ = 0;
+
   public:
     // These are exposed as read-only accessors rather than methods:
     Napi::Value needsDump(const Napi::CallbackInfo& info);
@@ -38,6 +121,7 @@ class ConfigBaseImpl {
     Napi::Value makeDump(const Napi::CallbackInfo& info);
     void confirmPushed(const Napi::CallbackInfo& info);
     Napi::Value merge(const Napi::CallbackInfo& info);
+    Napi::Value mergeAsync(const Napi::CallbackInfo& info);
 
     // Called from a sub-type's Init function (typically indirectly, via InitHelper) to add the base
     // class properties/methods to the type.
@@ -57,18 +141,25 @@ class ConfigBaseImpl {
         properties.push_back(T::InstanceMethod("makeDump", &T::makeDump));
         properties.push_back(T::InstanceMethod("confirmPushed", &T::confirmPushed));
         properties.push_back(T::InstanceMethod("merge", &T::merge));
+        properties.push_back(T::InstanceMethod("mergeAsync", &T::mergeAsync));
 
         return properties;
     }
 
   protected:
     // Constructor (callable from a subclass): the wrapper subclass constructs its
-    // ConfigBase-derived shared_ptr during *its* construction, passing it here.  For example:
+    // ConfigBase-derived shared_ptr during *its* construction, passing it here along with its
+    // class name, a `static constexpr const char* CLASS_NAME` member, and the config_fingerprinter
+    // of the config if it has collections.  For example:
     //
     //     ConfigWhateverWrapper(const Napi::CallbackInfo& info) :
-    //         ConfigBaseImpl{construct<config::Whatever>(info), "Whatever"},
+    //         ConfigBaseImpl{construct<config::Whatever>(info, CLASS_NAME), CLASS_NAME},
     //         Napi::ObjectWrap<UserWhateverWrapper>{info} {}
-    ConfigBaseImpl(std::shared_ptr<session::config::ConfigBase> conf) : conf_{std::move(conf)} {
+    ConfigBaseImpl(
+            std::shared_ptr<session::config::ConfigBase> conf,
+            const char* class_name,
+            config_fingerprinter fingerprints = no_collections) :
+            conf_{std::move(conf)}, class_name_{class_name}, fingerprints_{fingerprints} {
         if (!conf_)
             throw std::invalid_argument{
                     "ConfigBaseImpl initialization requires a live ConfigBase pointer"};
@@ -77,29 +168,60 @@ class ConfigBaseImpl {
     // Constructs a shared_ptr of some config::ConfigBase-derived type, taking a secret key and
     // optional dump.  This is what most Config types require, but a subclass could replace this if
     // it needs to do something else.
+    //
+    // Alternatively, the wrapper adopts an already constructed config (see adopt_config()): that
+    // is how createAsync() and MetaUserWrapper create the wrappers of the configs they load.
     template <
             typename Config,
             std::enable_if_t<std::is_base_of_v<config::ConfigBase, Config>, int> = 0>
     static std::shared_ptr<Config> construct(
-            const Napi::CallbackInfo& info, const std::string& class_name) {
+            const Napi::CallbackInfo& info, const char* class_name) {
+        instrumentation::ClassScope scope{class_name};
         return wrapExceptions(info, [&] {
             if (!info.IsConstructCall())
                 throw std::invalid_argument{
                         "You need to call the constructor with the `new` syntax"};
 
-            assertInfoLength(info, 2);
+            if (auto* base = adopted<std::shared_ptr<config::ConfigBase>>(info)) {
+                auto conf = std::dynamic_pointer_cast<Config>(*base);
+                if (!conf)
+                    throw std::invalid_argument{
+                            std::string{class_name} + ": adopted config of the wrong type"};
+                return conf;
+            }
 
-            // we should get secret key as first arg and optional dumped as second argument
-            assertIsUInt8Array(info[0], "base construct");
-            assertIsUInt8ArrayOrNull(info[1]);
-            std::vector<unsigned char> secretKey = toCppBuffer(info[0], class_name + ".new");
+            auto args = config_args_from_JS(info, std::string{class_name} + ".new");
+            return std::make_shared<Config>(args.secret_key, args.dump);
+        });
+    }
 
-            std::optional<std::vector<unsigned char>> dump;
-            auto second = info[1];
-            if (!second.IsEmpty() && !second.IsNull() && !second.IsUndefined())
-                dump = toCppBuffer(second, class_name + ".new");
+    // The static `createAsync(secretKey, dump)` of the wrapper classes, registered in their Init
+    // with `StaticMethod<&createAsync<Wrapper, Config>>("createAsync")`: same as their constructor,
+    // but the config (and so its dump) is loaded on the libuv threadpool, and the promise resolves
+    // to the wrapper then constructed around it.
+    template <
+            typename Wrapper,
+            typename Config,
+            std::enable_if_t<std::is_base_of_v<config::ConfigBase, Config>, int> = 0>
+    static Napi::Value createAsync(const Napi::CallbackInfo& info) {
+        instrumentation::ClassScope scope{Wrapper::CLASS_NAME};
+        return wrapResult(info, [&] {
+            auto args =
+                    config_args_from_JS(info, std::string{Wrapper::CLASS_NAME} + ".createAsync");
+            auto cls = called_class(info);
 
-            return std::make_shared<Config>(secretKey, dump);
+            auto* worker = makePromiseWorker(
+                    info.Env(),
+                    "ConfigBaseImpl::createAsync",
+                    [args = std::move(args)] {
+                        return std::shared_ptr<config::ConfigBase>{
+                                std::make_shared<Config>(args.secret_key, args.dump)};
+                    },
+                    [cls = Napi::Persistent(cls)](
+                            const Napi::Env&, std::shared_ptr<config::ConfigBase> conf) {
+                        return adopt_config(cls.Value(), std::move(conf));
+                    });
+            return worker->QueuePromise();
         });
     }
 
@@ -107,17 +229,41 @@ class ConfigBaseImpl {
 
     // Accesses a reference the stored config instance as `std::shared_ptr<T>` (if no template is
     // specified then as the base ConfigBase type).  `T` must be a subclass of ConfigBase for this
-    // to compile.  Throws std::logic_error if not set.  Throws std::invalid_argument if the
-    // instance is not castable to a `T`.
+    // to compile.  Throws std::logic_error if not set, or if an async job currently owns the
+    // config.  Throws std::invalid_argument if the instance is not castable to a `T`.  Since this
+    // can throw, call it from inside a wrapResult/wrapExceptions lambda.
     template <typename T, std::enable_if_t<std::is_base_of_v<config::ConfigBase, T>, int> = 0>
     T& get_config() {
         assert(conf_);  // should not be possible to construct without this set
+        assertNotBusy();
         if (auto* t = dynamic_cast<T*>(conf_.get()))
             return *t;
         throw std::invalid_argument{
                 "Error retrieving config: config instance is not of the requested type"};
     }
 
+    // Throws if an async job is currently running against this config.
+    void assertNotBusy() const {
+        if (busy_)
+            throw std::logic_error{
+                    "Config is busy: an async operation on this config has not completed yet"};
+    }
+
+    // To be called by the methods setting or erasing entries, merging, pushing, etc.: invalidates
+    // the cursors over the config, whose iterators may not survive the change.
+    void mutated() { mutation_epoch_++; }
+
+    // Returns the guard of a cursor created now over the config (see ConfigCursor): throws if the
+    // config is busy, or if it was mutated() since.
+    std::function<void()> cursor_guard() {
+        return [this, epoch = mutation_epoch_] {
+            assertNotBusy();
+            if (mutation_epoch_ != epoch)
+                throw std::logic_error{
+                        "Config was modified during iteration: the cursor cannot continue"};
+        };
+    }
+
     // Helper function for doing the subtype napi Init call.  This sets up the class registration,
     // sets it in the exports, and appends the base methods and properties (needsDump, etc.) to the
     // given methods/properties list.
@@ -131,9 +277,7 @@ class ConfigBaseImpl {
         Napi::Function cls =
                 T::DefineClass(env, class_name, WithBaseMethods<T>(std::move(properties)));
 
-        auto ref = std::make_unique<Napi::FunctionReference>();
-        *ref = Napi::Persistent(cls);
-        env.SetInstanceData(ref.release());
+        AddonData::get(env).add_constructor(class_name, cls);
 
         exports.Set(class_name, cls);
     }
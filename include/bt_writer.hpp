@@ -0,0 +1,84 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace session::nodeapi {
+
+inline std::string_view as_string_view(std::span<const unsigned char> bytes) {
+    return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+}
+
+inline std::span<const unsigned char> as_span(std::string_view str) {
+    return {reinterpret_cast<const unsigned char*>(str.data()), str.size()};
+}
+
+// Writes bt-encoded values to `out`, which the same writes with a null `out` have sized: see
+// write_bt().
+class bt_writer {
+  public:
+    explicit bt_writer(unsigned char* out = nullptr) : out_{out} {}
+
+    size_t size() const { return size_; }
+
+    void raw(std::string_view bytes) {
+        if (out_)
+            std::memcpy(out_ + size_, bytes.data(), bytes.size());
+        size_ += bytes.size();
+    }
+    void raw(char c) { raw(std::string_view{&c, 1}); }
+
+    void number(int64_t n) {
+        char digits[20];
+        auto end = std::to_chars(std::begin(digits), std::end(digits), n).ptr;
+        raw(std::string_view{digits, static_cast<size_t>(end - digits)});
+    }
+
+    void string(std::string_view str) {
+        number(static_cast<int64_t>(str.size()));
+        raw(':');
+        raw(str);
+    }
+    void string(std::span<const unsigned char> bytes) { string(as_string_view(bytes)); }
+
+    void integer(int64_t n) {
+        raw('i');
+        number(n);
+        raw('e');
+    }
+
+    template <typename Strings>
+    void list(const Strings& strings) {
+        raw('l');
+        for (const auto& str : strings)
+            string(str);
+        raw('e');
+    }
+
+  private:
+    unsigned char* out_;
+    size_t size_ = 0;
+};
+
+// Returns what `write(bt_writer&)` writes, in a single allocation.  Combined dumps are mostly made
+// of the dumps of their configs, which can be large: rather than building them up in (and then
+// copying them out of) a bt_dict_producer, they are sized by a first call, then written in place
+// by a second one, which must write the very same.
+template <typename Write>
+std::vector<unsigned char> write_bt(Write&& write) {
+    bt_writer counter;
+    write(counter);
+
+    std::vector<unsigned char> out(counter.size());
+    bt_writer writer{out.data()};
+    write(writer);
+    return out;
+}
+
+}  // namespace session::nodeapi
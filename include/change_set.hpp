@@ -0,0 +1,121 @@
+#pragma once
+
+#include <napi.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "utilities.hpp"
+
+namespace session::nodeapi {
+
+/// 64-bit FNV-1a hash of the fields of a config entry, to tell whether the entry changed:
+///
+///     fingerprint.add(c.session_id, c.name, c.priority, ...).value()
+///
+/// Accepts strings, arithmetic and enum values, chrono durations and time points, contiguous
+/// ranges of those (e.g. byte vectors) and optionals of any of these.  Variable-length values are
+/// hashed along with their length, so that `("ab", "c")` and `("a", "bc")` differ.
+class Fingerprint {
+  public:
+    template <typename... T>
+    Fingerprint& add(const T&... vals) {
+        (add_one(vals), ...);
+        return *this;
+    }
+
+    uint64_t value() const { return hash_; }
+
+  private:
+    uint64_t hash_ = 0xcbf29ce484222325;
+
+    void add_bytes(const void* data, size_t size);
+
+    template <typename T>
+    void add_one(const T& val) {
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            std::string_view str = val;
+            add_one(str.size());
+            add_bytes(str.data(), str.size());
+        } else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+            add_bytes(&val, sizeof(val));
+        } else if constexpr (requires { val.time_since_epoch(); }) {
+            add_one(val.time_since_epoch());
+        } else if constexpr (requires { val.count(); }) {
+            add_one(val.count());
+        } else if constexpr (requires {
+                                 val.has_value();
+                                 *val;
+                             }) {
+            add_one(val.has_value());
+            if (val)
+                add_one(*val);
+        } else if constexpr (std::ranges::contiguous_range<T>) {
+            using Elem = std::ranges::range_value_t<T>;
+            static_assert(std::is_arithmetic_v<Elem> || std::is_enum_v<Elem> ||
+                          std::is_same_v<Elem, std::byte>);
+            add_one(std::ranges::size(val));
+            add_bytes(std::ranges::data(val), std::ranges::size(val) * sizeof(Elem));
+        } else {
+            static_assert(!sizeof(T), "Fingerprint: unsupported field type");
+        }
+    }
+};
+
+// The fingerprints of the entries of one collection of a config, keyed by the entries' key (e.g.
+// the session id of a contact).
+using entry_fingerprints = std::unordered_map<std::string, uint64_t>;
+
+// The fingerprints of all the collections of a config, keyed by collection name ("contact",
+// "community", ...).
+using config_fingerprints = std::map<std::string, entry_fingerprints>;
+
+// Fingerprints the entries of [it, end) with `keyed_fingerprint(entry)`, which returns the
+// `{key, fingerprint}` of an entry.
+template <typename It, typename EndIt, typename KeyedFingerprint>
+entry_fingerprints fingerprint_all(It it, EndIt end, KeyedFingerprint keyed_fingerprint) {
+    entry_fingerprints fps;
+    for (; it != end; ++it)
+        fps.insert(keyed_fingerprint(*it));
+    return fps;
+}
+
+// The keys of the entries of a collection added, updated and removed between two states of it;
+// each list is sorted.
+struct change_set {
+    std::vector<std::string> added;
+    std::vector<std::string> updated;
+    std::vector<std::string> removed;
+};
+
+// The change sets of all the collections of a config, keyed by collection name.
+using config_changes = std::map<std::string, change_set>;
+
+change_set diff_fingerprints(const entry_fingerprints& before, const entry_fingerprints& after);
+config_changes diff_fingerprints(
+        const config_fingerprints& before, const config_fingerprints& after);
+
+// Whether the `options` argument of merge()/metaMerge() (`{changeSet?: boolean}`, or undefined)
+// asks for the change set.
+bool change_set_requested(const Napi::Value& options);
+
+template <>
+struct toJs_impl<change_set> {
+    Napi::Object operator()(const Napi::Env& env, const change_set& changes) const;
+};
+
+template <>
+struct toJs_impl<config_changes> {
+    Napi::Object operator()(const Napi::Env& env, const config_changes& changes) const;
+};
+
+}  // namespace session::nodeapi
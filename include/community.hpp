@@ -1,19 +1,24 @@
+#include "object_shape.hpp"
 #include "session/config/community.hpp"
 #include "utilities.hpp"
 
 namespace session::nodeapi {
 
+inline constexpr ObjectShape community_shape{
+        "fullUrlWithPubkey",
+        "baseUrl",
+        "roomCasePreserved",
+        "pubkeyHex"};
+
 template <>
 struct toJs_impl<config::community> {
     Napi::Object operator()(const Napi::Env& env, const config::community info_comm) {
-        auto obj = Napi::Object::New(env);
-
-        obj["fullUrlWithPubkey"] = toJs(env, info_comm.full_url());
-        obj["baseUrl"] = toJs(env, info_comm.base_url());
-        obj["roomCasePreserved"] = toJs(env, info_comm.room());
-        obj["pubkeyHex"] = toJs(env, info_comm.pubkey_hex());
-
-        return obj;
+        return community_shape.make(
+                env,
+                toJs(env, info_comm.full_url()),
+                toJs(env, info_comm.base_url()),
+                toJs(env, info_comm.room()),
+                toJs(env, info_comm.pubkey_hex()));
     }
 };
 
@@ -7,18 +7,32 @@
 
 namespace session::nodeapi {
 
+template <>
+struct toJs_impl<config::contact_info> {
+    Napi::Object operator()(const Napi::Env& env, const config::contact_info& contact) const;
+};
+
 class ContactsConfigWrapper : public ConfigBaseImpl,
                               public Napi::ObjectWrap<ContactsConfigWrapper> {
   public:
+    static constexpr const char* CLASS_NAME = "ContactsConfigWrapper";
+
     static void Init(Napi::Env env, Napi::Object exports);
 
     explicit ContactsConfigWrapper(const Napi::CallbackInfo& info);
 
   private:
-    config::Contacts& config{get_config<config::Contacts>()};
+    config::Contacts& config() { return get_config<config::Contacts>(); }
 
     Napi::Value get(const Napi::CallbackInfo& info);
     Napi::Value getAll(const Napi::CallbackInfo& info);
+
+    // getAllColumnar(fields): the requested `fields` of every contact, one column per field
+    // rather than one object per contact; see ContactsColumnar in the typings for the layout.
+    Napi::Value getAllColumnar(const Napi::CallbackInfo& info);
+
+    // iterate({batchSize?, fields?}): a ConfigCursor over the contacts.
+    Napi::Value iterate(const Napi::CallbackInfo& info);
     void set(const Napi::CallbackInfo& info);
     Napi::Value erase(const Napi::CallbackInfo& info);
 };
@@ -10,12 +10,14 @@ namespace session::nodeapi {
 class ConvoInfoVolatileWrapper : public ConfigBaseImpl,
                                  public Napi::ObjectWrap<ConvoInfoVolatileWrapper> {
   public:
+    static constexpr const char* CLASS_NAME = "ConvoInfoVolatileWrapper";
+
     static void Init(Napi::Env env, Napi::Object exports);
 
     explicit ConvoInfoVolatileWrapper(const Napi::CallbackInfo& info);
 
   private:
-    config::ConvoInfoVolatile& config{get_config<config::ConvoInfoVolatile>()};
+    config::ConvoInfoVolatile& config() { return get_config<config::ConvoInfoVolatile>(); }
 
     // 1o1 related methods
     Napi::Value get1o1(const Napi::CallbackInfo& info);
@@ -40,6 +42,10 @@ class ConvoInfoVolatileWrapper : public ConfigBaseImpl,
     Napi::Value getAllCommunities(const Napi::CallbackInfo& info);
     void setCommunityByFullUrl(const Napi::CallbackInfo& info);
     Napi::Value eraseCommunityByFullUrl(const Napi::CallbackInfo& info);
+
+    // iterate({type, batchSize?, fields?}): a ConfigCursor over the 1o1s, legacy groups, groups or
+    // communities (`type` "1o1", "legacyGroup", "group" or "community").
+    Napi::Value iterate(const Napi::CallbackInfo& info);
 };
 
 }  // namespace session::nodeapi
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <napi.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "object_shape.hpp"
+#include "utilities.hpp"
+
+namespace session::nodeapi {
+
+/// What a ConfigCursor iterates over: one collection of a config, converted a batch at a time.
+class CursorSource {
+  public:
+    virtual ~CursorSource() = default;
+
+    // Converts the next (up to) `n` entries; returns an empty array once exhausted.
+    virtual Napi::Array next(const Napi::Env& env, size_t n) = 0;
+};
+
+// A CursorSource over [it, end), converting the entries of each batch with `convert(env)(entry)`:
+// `convert(env)` is called once per batch, to resolve what the conversions of the batch share
+// (e.g. a FieldConverter), which cannot be kept from one batch to the next.
+template <typename It, typename EndIt, typename Convert>
+class IteratorSource final : public CursorSource {
+  public:
+    IteratorSource(It it, EndIt end, Convert convert) :
+            it_{std::move(it)}, end_{std::move(end)}, convert_{std::move(convert)} {}
+
+    Napi::Array next(const Napi::Env& env, size_t n) override {
+        auto batch = Napi::Array::New(env);
+        auto convert = convert_(env);
+        uint32_t i = 0;
+        for (; i < n && it_ != end_; ++it_)
+            batch[i++] = convert(*it_);
+        return batch;
+    }
+
+  private:
+    It it_;
+    EndIt end_;
+    Convert convert_;
+};
+
+// The options of the iterate() methods: `{batchSize?: number, type?: string, fields?: string[]}`.
+struct cursor_options {
+    size_t batch_size = 256;
+    // The collection to iterate over, for the configs holding several (e.g. user groups).
+    std::optional<std::string> type;
+    // The field projection, as taken by FieldTable::mask_from_JS().
+    Napi::Value fields;
+};
+
+cursor_options cursor_options_from_JS(const Napi::Value& val);
+
+/// The JS object returned by the iterate() methods of the config wrappers, iterating over one of
+/// their collections by batches: `next()` returns the next (up to) `batchSize` entries, and an
+/// empty array once done.  Unlike the getAll* methods, this bounds how many entries get converted,
+/// and so how long the JS thread is blocked, per call.
+///
+/// The cursor holds libsession iterators into the config, which do not survive changes to it: the
+/// guard given by the wrapper (see ConfigBaseImpl::cursor_guard) runs before each batch, and throws
+/// if the config changed since the cursor was created.  The cursor keeps its wrapper alive until
+/// it is exhausted or close()d.
+class ConfigCursor : public Napi::ObjectWrap<ConfigCursor> {
+  public:
+    static void Init(Napi::Env env, Napi::Object exports);
+
+    // Only constructible through make(); throws if called from JS.
+    explicit ConfigCursor(const Napi::CallbackInfo& info);
+
+    // Creates a cursor over `source` for the wrapper `owner`, checking `guard` before each batch.
+    static Napi::Object make(
+            Napi::Env env,
+            Napi::Object owner,
+            std::function<void()> guard,
+            std::unique_ptr<CursorSource> source,
+            size_t batch_size);
+
+  private:
+    Napi::ObjectReference owner_;
+    std::function<void()> guard_;
+    std::unique_ptr<CursorSource> source_;
+    size_t batch_size_ = 0;
+
+    // Drops the iterators and the reference to the wrapper; next() then returns empty batches.
+    void release();
+
+    Napi::Value next(const Napi::CallbackInfo& info);
+    void close(const Napi::CallbackInfo& info);
+};
+
+// Creates the ConfigCursor returned by the wrapper method call `info`, over [it, end), converting
+// the entries with `convert(env)(entry)` (see IteratorSource).
+template <typename It, typename EndIt, typename Convert>
+Napi::Object make_cursor(
+        const Napi::CallbackInfo& info,
+        std::function<void()> guard,
+        size_t batch_size,
+        It it,
+        EndIt end,
+        Convert convert) {
+    return ConfigCursor::make(
+            info.Env(),
+            info.This().As<Napi::Object>(),
+            std::move(guard),
+            std::make_unique<IteratorSource<It, EndIt, Convert>>(
+                    std::move(it), std::move(end), std::move(convert)),
+            batch_size);
+}
+
+// Same as make_cursor(), converting the entries through their entity FieldTable (see
+// entity_fields) with the projection of `opts`.
+template <typename It, typename EndIt>
+Napi::Object make_entity_cursor(
+        const Napi::CallbackInfo& info,
+        std::function<void()> guard,
+        const cursor_options& opts,
+        It it,
+        EndIt end) {
+    using T = std::remove_cvref_t<decltype(*it)>;
+    const auto& table = entity_fields<T>::fields;
+    return make_cursor(
+            info,
+            std::move(guard),
+            opts.batch_size,
+            std::move(it),
+            std::move(end),
+            [&table, mask = table.mask_from_JS(opts.fields)](const Napi::Env& env) {
+                return table.converter(env, mask);
+            });
+}
+
+}  // namespace session::nodeapi
@@ -58,6 +58,18 @@ class MultiEncryptWrapper : public Napi::ObjectWrap<MultiEncryptWrapper> {
                                 "encryptForGroup",
                                 static_cast<napi_property_attributes>(
                                         napi_writable | napi_configurable)),
+                        StaticMethod<&MultiEncryptWrapper::encryptFor1o1Async>(
+                                "encryptFor1o1Async",
+                                static_cast<napi_property_attributes>(
+                                        napi_writable | napi_configurable)),
+                        StaticMethod<&MultiEncryptWrapper::encryptForCommunityAsync>(
+                                "encryptForCommunityAsync",
+                                static_cast<napi_property_attributes>(
+                                        napi_writable | napi_configurable)),
+                        StaticMethod<&MultiEncryptWrapper::encryptForGroupAsync>(
+                                "encryptForGroupAsync",
+                                static_cast<napi_property_attributes>(
+                                        napi_writable | napi_configurable)),
 
                         // Destination decrypt
                         StaticMethod<&MultiEncryptWrapper::decryptForCommunity>(
@@ -72,6 +84,14 @@ class MultiEncryptWrapper : public Napi::ObjectWrap<MultiEncryptWrapper> {
                                 "decryptForGroup",
                                 static_cast<napi_property_attributes>(
                                         napi_writable | napi_configurable)),
+                        StaticMethod<&MultiEncryptWrapper::decryptFor1o1Async>(
+                                "decryptFor1o1Async",
+                                static_cast<napi_property_attributes>(
+                                        napi_writable | napi_configurable)),
+                        StaticMethod<&MultiEncryptWrapper::decryptForGroupAsync>(
+                                "decryptForGroupAsync",
+                                static_cast<napi_property_attributes>(
+                                        napi_writable | napi_configurable)),
                 });
     }
 
@@ -98,6 +118,12 @@ class MultiEncryptWrapper : public Napi::ObjectWrap<MultiEncryptWrapper> {
     static Napi::Value encryptForCommunityInbox(const Napi::CallbackInfo& info);
     static Napi::Value encryptForCommunity(const Napi::CallbackInfo& info);
     static Napi::Value encryptForGroup(const Napi::CallbackInfo& info);
+
+    // Same as encryptFor1o1/encryptForCommunity/encryptForGroup, but the batch is encoded on the
+    // libuv threadpool, spread across several threads, and a Promise of the result is returned.
+    static Napi::Value encryptFor1o1Async(const Napi::CallbackInfo& info);
+    static Napi::Value encryptForCommunityAsync(const Napi::CallbackInfo& info);
+    static Napi::Value encryptForGroupAsync(const Napi::CallbackInfo& info);
     /**
      * ===========================================
      * ============= DECRYPT CALLS ===============
@@ -107,5 +133,10 @@ class MultiEncryptWrapper : public Napi::ObjectWrap<MultiEncryptWrapper> {
     static Napi::Value decryptForCommunity(const Napi::CallbackInfo& info);
     static Napi::Value decryptFor1o1(const Napi::CallbackInfo& info);
     static Napi::Value decryptForGroup(const Napi::CallbackInfo& info);
+
+    // Same as decryptFor1o1/decryptForGroup, but the batch is decoded on the libuv threadpool,
+    // spread across several threads, and a Promise of the result is returned.
+    static Napi::Value decryptFor1o1Async(const Napi::CallbackInfo& info);
+    static Napi::Value decryptForGroupAsync(const Napi::CallbackInfo& info);
 };
 };  // namespace session::nodeapi
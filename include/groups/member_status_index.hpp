@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "session/config/groups/members.hpp"
+
+namespace session::nodeapi {
+
+using config::groups::member;
+using config::groups::Members;
+
+// The JS name of a member status.  Always a string literal, so that it can be interned.
+const char* member_status_string(member::Status status);
+
+// All the member statuses, in the order of their codes (see member_status_code()).
+inline constexpr std::array all_member_statuses{
+        member::Status::invite_unknown,
+        member::Status::invite_not_sent,
+        member::Status::invite_sending,
+        member::Status::invite_failed,
+        member::Status::invite_sent,
+        member::Status::invite_accepted,
+        member::Status::promotion_unknown,
+        member::Status::promotion_not_sent,
+        member::Status::promotion_sending,
+        member::Status::promotion_failed,
+        member::Status::promotion_sent,
+        member::Status::promotion_accepted,
+        member::Status::removed_unknown,
+        member::Status::removed,
+        member::Status::removed_including_messages,
+};
+
+// The code of a member status: its index in all_member_statuses, which is what the MEMBER_STATUS
+// constants map the statuses' JS names to.
+uint8_t member_status_code(member::Status status);
+
+/// The session ids of the members of a group, by status.  Answers the "how many members have this
+/// status" and "which members have these statuses" queries without going through all the members
+/// and computing the status of each.
+///
+/// It is up to the owner to keep it current: by update()ing it whenever a member is set, and by
+/// rebuild()ing it after changes it cannot follow member by member (merges, erasures, ...).
+class MemberStatusIndex {
+  public:
+    // Indexes all the `members`, replacing the previous content.
+    void rebuild(const Members& members);
+
+    // Records `status` as the current status of the member `session_id`.
+    void update(const std::string& session_id, member::Status status);
+
+    // The number of members having `status`.
+    size_t count(member::Status status) const;
+
+    // The session ids of the members having any of `statuses`, sorted.
+    std::vector<std::string> members_with(std::span<const member::Status> statuses) const;
+
+  private:
+    std::unordered_map<std::string, member::Status> status_of_;
+    std::map<member::Status, std::set<std::string>> by_status_;
+};
+
+}  // namespace session::nodeapi
@@ -2,9 +2,13 @@
 
 #include <napi.h>
 
+#include <functional>
+#include <optional>
+
 #include "../meta/meta_base_wrapper.hpp"
 #include "../profile_pic.hpp"
 #include "../utilities.hpp"
+#include "./member_status_index.hpp"
 #include "./meta_group.hpp"
 #include "oxenc/bt_producer.h"
 #include "session/config/groups/members.hpp"
@@ -18,7 +22,18 @@ using session::config::NOT_REMOVED;
 using session::config::groups::member;
 using session::nodeapi::MetaGroup;
 
-Napi::Object member_to_js(const Napi::Env& env, const member& info, const member::Status& status);
+// A member along with its status, which is what the members' FieldTable converts.
+struct member_entry {
+    const member& info;
+    member::Status status;
+};
+
+// Converts a member to JS; `mask` selects the fields to convert, all of them by default.
+Napi::Object member_to_js(
+        const Napi::Env& env,
+        const member& info,
+        const member::Status& status,
+        FieldMask mask = ALL_FIELDS);
 
 template <>
 struct toJs_impl<Keys::swarm_auth> {
@@ -32,14 +47,132 @@ struct toJs_impl<Keys::swarm_auth> {
     }
 };
 
+// The marshalled arguments of metaMerge: the (hash, data) key messages along with their
+// timestampMs, then the (hash, data) pairs of the info and members configs.  See merge_entries for
+// when the data is borrowed rather than owned.
+struct meta_merge_input {
+    merge_entries keys;
+    std::vector<int64_t> keys_timestamp_ms;
+    merge_entries info;
+    merge_entries members;
+};
+
+struct meta_merge_result {
+    int count = 0;
+    bool rekeyed = false;
+};
+
+template <>
+struct toJs_impl<meta_merge_result> {
+    Napi::Object operator()(const Napi::Env& env, const meta_merge_result& res) {
+        auto obj = Napi::Object::New(env);
+
+        obj["count"] = toJs(env, res.count);
+        obj["rekeyed"] = toJs(env, res.rekeyed);
+        return obj;
+    }
+};
+
+// Unless `copy` is set the result borrows the JS buffers, so it must not outlive the current call.
+meta_merge_input meta_merge_input_from_JS(const Napi::Value& arg, bool copy);
+
+// Merges `input` into `group`, keys first, and rekeys if that leaves the keys needing it.  Touches
+// no JS values, so this can run off the main thread.
+meta_merge_result meta_merge(MetaGroup& group, const meta_merge_input& input);
+
 class MetaGroupWrapper : public Napi::ObjectWrap<MetaGroupWrapper> {
   public:
     static void Init(Napi::Env env, Napi::Object exports);
 
     explicit MetaGroupWrapper(const Napi::CallbackInfo& info);
 
+    // MetaGroupWrapperNode.createAsync(options): same as the constructor, but the group is loaded
+    // on the libuv threadpool; resolves to the new wrapper.
+    static Napi::Value createAsync(const Napi::CallbackInfo& info);
+
+    // MetaGroupWrapperNode.loadMany([options, ...]): loads the groups in parallel on the libuv
+    // threadpool; resolves to their `{group, error}`, in input order.
+    static Napi::Value loadMany(const Napi::CallbackInfo& info);
+
   private:
-    std::unique_ptr<MetaGroup> meta_group;
+    std::unique_ptr<MetaGroup> meta_group_;
+
+    // Set while an async job (metaMergeAsync) is operating on `meta_group_` from the threadpool.
+    // Only touched on the JS thread.
+    bool busy_ = false;
+
+    // A group constructed from a dump is only loaded (its configs parsed, its keys constructed)
+    // by the first method that needs it: until then `meta_group_` is null, and this holds what to
+    // load it from.  Many groups are loaded at startup and never touched afterwards but to be
+    // dumped or asked whether they need pushing, which their dump can answer on its own.
+    // NB: `dump` views into `args.dumped_meta`, so this is moved but never copied.
+    struct pending_group {
+        group_wrapper_args args;
+        group_dump dump;
+    };
+    std::optional<pending_group> pending_;
+
+    // Set when that dump has no metadata (it was made by an older version): needsDump() then
+    // reports true, loaded or not, until metaDump() has rewritten it with some.  Otherwise the
+    // groups never changed again would keep their dump as is, and be loaded on every startup.
+    bool dump_lacks_metadata_ = false;
+
+    // Accesses the wrapped group, loading it first if needed.  Throws if an async job currently
+    // owns it.
+    MetaGroup* meta_group() {
+        if (busy_)
+            throw std::logic_error{
+                    "MetaGroup is busy: an async operation on this group has not completed yet"};
+        if (!meta_group_) {
+            meta_group_ = MetaBaseWrapper::loadMetaGroup(pending_->args, &pending_->dump);
+            pending_.reset();
+        }
+        return meta_group_.get();
+    }
+
+    // The metadata recorded in the dump of the group, if it is not loaded yet and the dump has
+    // some; null otherwise, and then answering from it needs meta_group().
+    const group_dump_metadata* pending_metadata() const {
+        return pending_ && pending_->dump.metadata ? &*pending_->dump.metadata : nullptr;
+    }
+
+    // Bumped by every call that changes, or may change, the members (see mutated()), so that the
+    // ConfigCursors iterating over them can detect it.  Only touched on the JS thread.
+    uint64_t mutation_epoch_ = 0;
+
+    // To be called by the methods setting or erasing members, merging, pushing, etc.: invalidates
+    // the cursors over the members, whose iterators may not survive the change.
+    void mutated() { mutation_epoch_++; }
+
+    // Returns the guard of a cursor created now over the members (see ConfigCursor): throws if the
+    // group is busy, or if it was mutated() since.
+    std::function<void()> cursor_guard() {
+        return [this, epoch = mutation_epoch_] {
+            meta_group();  // throws if busy
+            if (mutation_epoch_ != epoch)
+                throw std::logic_error{
+                        "Group members were modified during iteration: the cursor cannot continue"};
+        };
+    }
+
+    // Bumped by the calls that may change which members there are, or their status, in ways the
+    // status index cannot follow (merges, erasing, resetting the sending state): unlike
+    // `mutation_epoch_`, not by pushes and confirmations, which leave both as they are.
+    uint64_t member_status_epoch_ = 0;
+
+    // To be called along with mutated() by those calls: has member_index() rebuild the index.
+    void member_statuses_changed() { member_status_epoch_++; }
+
+    // The members by status, current as of `member_index_epoch_` (see member_index()).
+    MemberStatusIndex member_index_;
+    std::optional<uint64_t> member_index_epoch_;
+
+    // Returns the status index of the members, first rebuilding it if member_statuses_changed()
+    // since it was last current.  Throws if the group is busy.
+    const MemberStatusIndex& member_index();
+
+    // Same as mutated() then `members->set(m)`, keeping the status index current.
+    void set_member(const member& m);
 
     /* Shared Actions */
     Napi::Value needsPush(const Napi::CallbackInfo& info);
@@ -50,6 +183,7 @@ class MetaGroupWrapper : public Napi::ObjectWrap<MetaGroupWrapper> {
     Napi::Value metaMakeDump(const Napi::CallbackInfo& info);
     void metaConfirmPushed(const Napi::CallbackInfo& info);
     Napi::Value metaMerge(const Napi::CallbackInfo& info);
+    Napi::Value metaMergeAsync(const Napi::CallbackInfo& info);
 
     /** Info Actions */
     Napi::Value infoGet(const Napi::CallbackInfo& info);
@@ -59,6 +193,14 @@ class MetaGroupWrapper : public Napi::ObjectWrap<MetaGroupWrapper> {
     /** Members Actions */
     Napi::Value memberGetAll(const Napi::CallbackInfo& info);
     Napi::Value memberGetAllPendingRemovals(const Napi::CallbackInfo& info);
+    // memberGetAllCompact(): the pubkeys of all the members, packed, along with their status codes.
+    Napi::Value memberGetAllCompact(const Napi::CallbackInfo& info);
+    // memberCountsByStatus(): the number of members having each status.
+    Napi::Value memberCountsByStatus(const Napi::CallbackInfo& info);
+    // memberGetByStatus(statuses, fields?): the members having any of `statuses`.
+    Napi::Value memberGetByStatus(const Napi::CallbackInfo& info);
+    // memberIterate({batchSize?, fields?}): a ConfigCursor over the members.
+    Napi::Value memberIterate(const Napi::CallbackInfo& info);
     Napi::Value memberGet(const Napi::CallbackInfo& info);
     Napi::Value memberGetOrConstruct(const Napi::CallbackInfo& info);
     Napi::Value memberConstructAndSet(const Napi::CallbackInfo& info);
@@ -76,6 +218,9 @@ class MetaGroupWrapper : public Napi::ObjectWrap<MetaGroupWrapper> {
     void memberSetSupplement(const Napi::CallbackInfo& info);
     Napi::Value memberEraseAndRekey(const Napi::CallbackInfo& info);
     void membersMarkPendingRemoval(const Napi::CallbackInfo& info);
+    // membersApply([{pubkeyHex, op, ...}]): applies a batch of the changes of the above setters;
+    // returns the pubkeys of the members actually changed.
+    Napi::Value membersApply(const Napi::CallbackInfo& info);
 
     /** Keys Actions */
     Napi::Value keysNeedsRekey(const Napi::CallbackInfo& info);
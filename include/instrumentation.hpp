@@ -0,0 +1,180 @@
+#pragma once
+
+#include <napi.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <source_location>
+#include <stdexcept>
+
+namespace session::nodeapi::instrumentation {
+
+/// Opt-in per-method statistics for the calls going through wrapResult()/wrapExceptions().
+///
+/// Every wrapped call opens a CallScope keyed by the calling function (captured through
+/// std::source_location, so call sites need no changes).  While disabled, which is the default,
+/// a scope costs a single relaxed atomic load.  While enabled, the outermost scope on a thread
+/// records its duration, whether it threw, and the Uint8Array bytes converted in and out during
+/// the call; nested wrapped calls (e.g. get_all_impl() within a wrapResult()) are folded into the
+/// outer one.
+///
+/// The methods shared by several wrapper classes (those of ConfigBaseImpl) open a ClassScope, so
+/// that their calls are recorded per wrapper class rather than all together.
+///
+/// Only the synchronous part of a call is measured: the threadpool work of the *Async methods is
+/// not attributed to anything.
+
+inline std::atomic<bool> enabled{false};
+
+/// Log-linear latency histogram, in the manner of HdrHistogram: values below 16ns get a bucket
+/// each; above, each power-of-two range is split into 16 linear sub-buckets, so that any recorded
+/// value is reported within ~6% of its true value whatever its magnitude.
+class LatencyHistogram {
+  public:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr uint64_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKETS = SUB_BUCKETS * (64 - SUB_BUCKET_BITS + 1);
+
+    void record(uint64_t ns);
+
+    // Returns (an approximation of) the smallest recorded value that `p` (in [0, 1]) of the
+    // recorded values are less than or equal to, or 0 if nothing was recorded.
+    uint64_t percentile(double p) const;
+
+    void merge(const LatencyHistogram& other);
+
+  private:
+    std::array<uint64_t, BUCKETS> counts_{};
+    uint64_t total_ = 0;
+};
+
+struct MethodStats {
+    uint64_t calls = 0;
+    uint64_t errors = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t bytes_in = 0;
+    uint64_t bytes_out = 0;
+    LatencyHistogram latency;
+};
+
+// Adds one call of `function_name` (as given by std::source_location) to the statistics, under the
+// wrapper class `class_name` if not null (see ClassScope).
+void record(
+        const char* function_name,
+        const char* class_name,
+        uint64_t ns,
+        bool error,
+        uint64_t bytes_in,
+        uint64_t bytes_out);
+
+// Per-thread state of the current outermost CallScope.
+inline thread_local unsigned depth = 0;
+inline thread_local uint64_t bytes_in = 0;
+inline thread_local uint64_t bytes_out = 0;
+
+// Called by the buffer conversions; only counts while a call is being recorded on this thread.
+inline void count_bytes_in(size_t n) {
+    if (depth)
+        bytes_in += n;
+}
+inline void count_bytes_out(size_t n) {
+    if (depth)
+        bytes_out += n;
+}
+
+// The wrapper class set by the innermost ClassScope of the thread, if any.
+inline thread_local const char* current_class = nullptr;
+
+/// Has the calls starting within its lifetime recorded as methods of the wrapper class `name` (a
+/// string literal, e.g. "ContactsConfigWrapper"), rather than of the class that declares them:
+/// without it, `merge` of every config wrapper would be recorded as the same
+/// "ConfigBaseImpl::merge".  Opened before the wrapResult()/wrapExceptions() call.
+class ClassScope {
+  public:
+    explicit ClassScope(const char* name) : previous_{current_class} { current_class = name; }
+    ~ClassScope() { current_class = previous_; }
+
+    ClassScope(const ClassScope&) = delete;
+    ClassScope& operator=(const ClassScope&) = delete;
+
+  private:
+    const char* previous_;
+};
+
+class CallScope {
+  public:
+    explicit CallScope(const std::source_location& loc) {
+        if (!enabled.load(std::memory_order_relaxed))
+            return;
+        if (depth++ > 0) {
+            nested_ = true;
+            return;
+        }
+        function_name_ = loc.function_name();
+        class_name_ = current_class;
+        uncaught_ = std::uncaught_exceptions();
+        bytes_in = 0;
+        bytes_out = 0;
+        start_ = std::chrono::steady_clock::now();
+    }
+
+    ~CallScope() {
+        if (nested_) {
+            depth--;
+            return;
+        }
+        if (!function_name_)
+            return;
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        depth--;
+        record(
+                function_name_,
+                class_name_,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                std::uncaught_exceptions() > uncaught_,
+                bytes_in,
+                bytes_out);
+    }
+
+    CallScope(const CallScope&) = delete;
+    CallScope& operator=(const CallScope&) = delete;
+
+  private:
+    const char* function_name_ = nullptr;
+    const char* class_name_ = nullptr;
+    bool nested_ = false;
+    int uncaught_ = 0;
+    std::chrono::steady_clock::time_point start_;
+};
+
+class InstrumentationWrapper : public Napi::ObjectWrap<InstrumentationWrapper> {
+  public:
+    InstrumentationWrapper(const Napi::CallbackInfo& info) :
+            Napi::ObjectWrap<InstrumentationWrapper>{info} {
+        throw std::invalid_argument(
+                "InstrumentationWrapper is static and doesn't need to be constructed");
+    }
+
+    static void Init(Napi::Env env, Napi::Object exports);
+
+  private:
+    // setEnabled(enabled: boolean): starts or stops recording.  Stopping keeps what was recorded.
+    static void setEnabled(const Napi::CallbackInfo& info);
+
+    // getStats(): returns an object keyed by method name (e.g. "MetaGroupWrapper::metaMerge"; the
+    // methods the config wrappers share are keyed by the concrete wrapper, as in
+    // "ContactsConfigWrapper::merge" or "UserGroupsWrapper::createAsync"), each value holding the
+    // call and error counts, the cumulative/mean/p50/p99/max latencies in milliseconds and the
+    // bytes converted in and out.
+    static Napi::Value getStats(const Napi::CallbackInfo& info);
+
+    // resetStats(): discards everything recorded so far.
+    static void resetStats(const Napi::CallbackInfo& info);
+};
+
+}  // namespace session::nodeapi::instrumentation
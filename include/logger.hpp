@@ -0,0 +1,120 @@
+#pragma once
+
+#include <napi.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "meta/meta_base_wrapper.hpp"
+
+namespace session::nodeapi {
+
+/// Bounded multi-producer ring buffer of log lines, after Dmitry Vyukov's bounded MPMC queue.
+///
+/// Producers (any libsession thread that logs) never block nor take a lock: when the ring is full
+/// the line is dropped and counted instead.  The JS thread is the only consumer.
+class LogRing {
+  public:
+    static constexpr size_t CAPACITY = 4096;
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "LogRing capacity must be a power of 2");
+
+    LogRing() : slots_{std::make_unique<Slot[]>(CAPACITY)} {
+        for (size_t i = 0; i < CAPACITY; i++)
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    // Appends `line`, returning false (and counting a drop) if the ring is full.
+    bool try_push(std::string&& line) {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & (CAPACITY - 1)];
+            size_t seq = slot.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.line = std::move(line);
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Moves the oldest line into `line`, returning false if the ring is empty.
+    bool try_pop(std::string& line) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & (CAPACITY - 1)];
+            size_t seq = slot.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    line = std::move(slot.line);
+                    slot.line.clear();
+                    slot.seq.store(pos + CAPACITY, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Returns the number of lines dropped since the last call, resetting the count.
+    uint64_t take_dropped() { return dropped_.exchange(0, std::memory_order_relaxed); }
+
+  private:
+    struct Slot {
+        std::atomic<size_t> seq;
+        std::string line;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+    alignas(64) std::atomic<uint64_t> dropped_{0};
+};
+
+// Sets up the libsession -> console.log bridge for `env`.  Log lines are queued in a LogRing by
+// whichever thread logs them and flushed to JS in batches: at most one non-blocking
+// ThreadSafeFunction call is outstanding at any time, however many lines are logged meanwhile.
+void initLogBridge(Napi::Env env);
+
+class LoggerWrapper : public Napi::ObjectWrap<LoggerWrapper> {
+  public:
+    LoggerWrapper(const Napi::CallbackInfo& info) : Napi::ObjectWrap<LoggerWrapper>{info} {
+        throw std::invalid_argument("LoggerWrapper is static and doesn't need to be constructed");
+    }
+
+    static void Init(Napi::Env env, Napi::Object exports) {
+        MetaBaseWrapper::NoBaseClassInitHelper<LoggerWrapper>(
+                env,
+                exports,
+                "LoggerWrapperNode",
+                {
+                        StaticMethod<&LoggerWrapper::setLogLevel>(
+                                "setLogLevel",
+                                static_cast<napi_property_attributes>(
+                                        napi_writable | napi_configurable)),
+                });
+    }
+
+  private:
+    // setLogLevel(category: string | null, level: string): sets the level of a single log
+    // category (e.g. "nodeapi" for the warnings logged by this addon), or of every category when
+    // `category` is null.  Records below the level are discarded by oxen-logging before being
+    // formatted, so they never reach the JS bridge.
+    static void setLogLevel(const Napi::CallbackInfo& info);
+};
+
+}  // namespace session::nodeapi
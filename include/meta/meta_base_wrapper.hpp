@@ -3,6 +3,9 @@
 #include <napi.h>
 
 #include <memory>
+#include <optional>
+#include <span>
+#include <string>
 #include <vector>
 
 #include "../base_config.hpp"
@@ -10,6 +13,34 @@
 
 namespace session::nodeapi {
 
+// The options of the MetaGroupWrapper constructor (see GroupWrapperConstructor in the typings), as
+// owned copies: loading the group from them touches no JS value.
+struct group_wrapper_args {
+    std::vector<unsigned char> user_ed25519_secretkey;
+    std::vector<unsigned char> group_ed25519_pubkey;
+    std::optional<std::vector<unsigned char>> group_ed25519_secretkey;
+    std::optional<std::vector<unsigned char>> dumped_meta;
+};
+
+// What the combined dump of a group records besides the dumps of its configs: enough to answer
+// needsPush() and activeHashes() without loading the group.
+struct group_dump_metadata {
+    std::vector<std::string> info_hashes;
+    std::vector<std::string> keys_hashes;
+    std::vector<std::string> members_hashes;
+    bool needs_push = false;
+};
+
+// A combined dump (see MetaGroupWrapper::metaDump) split into the dumps of the group's configs:
+// these are views into the combined dump, which must outlive them.
+struct group_dump {
+    std::span<const unsigned char> info;
+    std::span<const unsigned char> keys;
+    std::span<const unsigned char> members;
+    // Missing from the dumps made before it was recorded.
+    std::optional<group_dump_metadata> metadata;
+};
+
 class MetaBaseWrapper {
 
   public:
@@ -27,15 +58,29 @@ class MetaBaseWrapper {
         // not adding the baseMethods here from withBaseMethods()
         Napi::Function cls = T::DefineClass(env, class_name, std::move(properties));
 
-        auto ref = std::make_unique<Napi::FunctionReference>();
-        *ref = Napi::Persistent(cls);
-        env.SetInstanceData(ref.release());
+        AddonData::get(env).add_constructor(class_name, cls);
 
         exports.Set(class_name, cls);
     }
 
-    static std::unique_ptr<session::nodeapi::MetaGroup> constructGroupWrapper(
-            const Napi::CallbackInfo& info, const std::string& class_name);
+    static group_wrapper_args parseGroupWrapperArgs(
+            const Napi::Value& arg, const std::string& class_name);
+
+    // Splits a combined dump, without parsing (or copying) the dumps of the configs.  Throws if
+    // one is missing.
+    static group_dump splitGroupDump(std::span<const unsigned char> dumped_meta);
+
+    // The inverse of splitGroupDump(), written in a single allocation.
+    static std::vector<unsigned char> combineGroupDump(const group_dump& dump);
+
+    // Loads the group, parsing its combined dump and constructing its keys.  Touches no JS value,
+    // so this can run off the main thread.
+    static std::unique_ptr<session::nodeapi::MetaGroup> loadMetaGroup(
+            const group_wrapper_args& args);
+
+    // Same, but loading the configs from `dump` (if not null) instead of `args.dumped_meta`.
+    static std::unique_ptr<session::nodeapi::MetaGroup> loadMetaGroup(
+            const group_wrapper_args& args, const group_dump* dump);
 };
 
 }  // namespace session::nodeapi
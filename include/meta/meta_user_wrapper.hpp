@@ -0,0 +1,74 @@
+#pragma once
+
+#include <napi.h>
+
+#include <array>
+#include <memory>
+
+#include "../base_config.hpp"
+
+namespace session::nodeapi {
+
+/// The four user configs (profile, contacts, user groups and convo volatile infos), loaded together
+/// from one combined dump and pushed, dumped and merged together, in one call each instead of four.
+///
+/// The configs themselves are still used through their usual wrappers, which `configs()` returns:
+/// this constructs them around the configs it loads (see ConfigBaseImpl::construct), and goes
+/// through them for its own operations, so that their busy state and cursors stay consistent
+/// whichever object a change is made through.
+class MetaUserWrapper : public Napi::ObjectWrap<MetaUserWrapper> {
+  public:
+    static void Init(Napi::Env env, Napi::Object exports);
+
+    // new MetaUserWrapperNode(secretKey, metaDumped | null)
+    explicit MetaUserWrapper(const Napi::CallbackInfo& info);
+
+    // MetaUserWrapperNode.createAsync(secretKey, metaDumped | null): same as the constructor, but
+    // the configs are loaded on the libuv threadpool; resolves to the new wrapper.
+    static Napi::Value createAsync(const Napi::CallbackInfo& info);
+
+    // The configs, in the order of USER_CONFIG_NAMES.
+    using loaded_configs = std::array<std::shared_ptr<config::ConfigBase>, 4>;
+
+    // Loads the configs from a combined dump, or as new ones without it.  Touches no JS value, so
+    // this can run off the main thread.
+    static loaded_configs load(const config_args& args);
+
+  private:
+    // One of the user configs: the JS object of its wrapper, kept alive by this one, and the
+    // wrapper itself.
+    struct user_config {
+        Napi::ObjectReference object;
+        ConfigBaseImpl* wrapper = nullptr;
+
+        // Throws if the config is busy, like the wrapper's own methods.
+        config::ConfigBase& config() { return wrapper->get_config<config::ConfigBase>(); }
+        void mutated() { wrapper->mutated(); }
+    };
+
+    // In the order of USER_CONFIG_NAMES.
+    std::array<user_config, 4> configs_;
+
+    // The configs, in the same order.  Throws if any of them is busy, so the methods that change
+    // several configs get them all before changing any, and never leave some of them changed.
+    std::array<config::ConfigBase*, 4> all_configs();
+
+    // Constructs the wrapper of `conf`, registered as `class_name`.
+    template <typename Wrapper>
+    static user_config adopt(
+            Napi::Env env, const char* class_name, std::shared_ptr<config::ConfigBase> conf);
+
+    // configs(): the wrappers of the configs, as {contacts, convoInfoVolatile, userGroups,
+    // userProfile}.
+    Napi::Value configs(const Napi::CallbackInfo& info);
+
+    Napi::Value needsPush(const Napi::CallbackInfo& info);
+    Napi::Value push(const Napi::CallbackInfo& info);
+    Napi::Value needsDump(const Napi::CallbackInfo& info);
+    Napi::Value metaDump(const Napi::CallbackInfo& info);
+    Napi::Value metaMakeDump(const Napi::CallbackInfo& info);
+    void metaConfirmPushed(const Napi::CallbackInfo& info);
+    Napi::Value metaMerge(const Napi::CallbackInfo& info);
+};
+
+}  // namespace session::nodeapi
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <napi.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "addon_data.hpp"
+
+namespace session::nodeapi {
+
+// The env's interned `names` (see AddonData::interned), as the keys of define_object().  They are
+// local handles, valid until the current call returns: the converters of whole collections resolve
+// them once per call rather than once per object.  The names must be string literals.
+template <size_t N>
+std::array<napi_value, N> interned_keys(
+        const Napi::Env& env, const std::array<const char*, N>& names) {
+    auto& addon = AddonData::get(env);
+    std::array<napi_value, N> keys;
+    for (size_t i = 0; i < N; i++)
+        keys[i] = addon.interned(names[i]);
+    return keys;
+}
+
+// Creates an object with the first `n` properties `keys[i]` = `values[i]`, in that order, defined
+// with a single napi_define_properties call.
+template <size_t N>
+Napi::Object define_object(
+        const Napi::Env& env,
+        const std::array<napi_value, N>& keys,
+        const std::array<napi_value, N>& values,
+        size_t n = N) {
+    std::array<napi_property_descriptor, N> props;
+    for (size_t i = 0; i < n; i++)
+        props[i] = {
+                nullptr,
+                keys[i],
+                nullptr,
+                nullptr,
+                nullptr,
+                values[i],
+                napi_default_jsproperty,
+                nullptr};
+
+    auto obj = Napi::Object::New(env);
+    napi_status status = napi_define_properties(env, obj, n, props.data());
+    NAPI_THROW_IF_FAILED(env, status, Napi::Object{});
+    return obj;
+}
+
+/// The property layout of the JS objects of one entity kind, defined once and used to construct
+/// every such object in one go:
+///
+///     static constexpr ObjectShape member_shape{"pubkeyHex", "name", ...};
+///
+///     return member_shape.make(env, toJs(env, m.session_id), toJs(env, m.name), ...);
+///
+/// make() takes exactly one value per property, in the order of the shape, and defines them all
+/// at once through define_object() (instead of one napi_set_named_property per field); when making
+/// many objects in one call, resolve the keys() once and pass them to make_with_keys().  As every
+/// object of a shape gets the very same properties in the very same order, whatever the values,
+/// they all end up sharing one V8 hidden class; converters must not add properties
+/// conditionally, but set them to null.
+///
+/// The property names must be string literals.  See FieldTable for entities that callers may want
+/// only some fields of.
+template <size_t N>
+struct ObjectShape {
+    std::array<const char*, N> names;
+
+    std::array<napi_value, N> keys(const Napi::Env& env) const { return interned_keys(env, names); }
+
+    template <typename... Values>
+    Napi::Object make(const Napi::Env& env, Values&&... values) const {
+        return make_with_keys(env, keys(env), std::forward<Values>(values)...);
+    }
+
+    template <typename... Values>
+    Napi::Object make_with_keys(
+            const Napi::Env& env, const std::array<napi_value, N>& keys, Values&&... values) const {
+        static_assert(sizeof...(Values) == N, "ObjectShape::make() needs one value per property");
+        std::array<napi_value, N> vals{Napi::Value{std::forward<Values>(values)}...};
+        return define_object(env, keys, vals);
+    }
+};
+
+template <typename... Names>
+ObjectShape(Names...) -> ObjectShape<sizeof...(Names)>;
+
+/// One field of a FieldTable: its JS property name (a string literal) and how to get its value.
+template <typename T>
+struct Field {
+    const char* name;
+    Napi::Value (*get)(const Napi::Env& env, const T& val);
+};
+
+/// Selects fields of a FieldTable: bit `i` set selects field `i`.
+using FieldMask = uint64_t;
+inline constexpr FieldMask ALL_FIELDS = ~FieldMask{0};
+
+/// The fields of the JS objects an entity type converts to, in order.  Like an ObjectShape, but
+/// also knowing how to get each field, so that a caller can ask for only some of the fields (a
+/// projection) and pay only for converting those:
+///
+///     static constexpr auto member_fields = field_table<member_entry>({
+///             {"pubkeyHex", [](auto& env, auto& m) -> Napi::Value { return toJs(env, ...); }},
+///             ...
+///     });
+///
+///     auto convert = member_fields.converter(env, member_fields.mask_from_JS(info[0]));
+///     ... convert(entry) ...
+///
+/// Objects converted with the same mask all share one hidden class.  Specializing entity_fields
+/// for the type makes get_all_impl() take an optional projection argument for it.
+template <typename T, size_t N>
+struct FieldTable;
+
+/// Converts entities through a FieldTable with a given mask, with the keys of the selected fields
+/// resolved once (see interned_keys): converting an entity then only costs getting the values of
+/// its fields, and the napi_define_properties call.  Like the keys, this is only valid until the
+/// current call returns.
+template <typename T, size_t N>
+class FieldConverter {
+  public:
+    FieldConverter(const FieldTable<T, N>& table, const Napi::Env& env, FieldMask mask) :
+            table_{table}, env_{env} {
+        auto& addon = AddonData::get(env);
+        for (size_t i = 0; i < N; i++) {
+            if (!(mask & (FieldMask{1} << i)))
+                continue;
+            selected_[n_] = i;
+            keys_[n_++] = addon.interned(table.fields[i].name);
+        }
+    }
+
+    Napi::Object operator()(const T& val) const {
+        std::array<napi_value, N> values;
+        for (size_t i = 0; i < n_; i++)
+            values[i] = table_.fields[selected_[i]].get(env_, val);
+        return define_object(env_, keys_, values, n_);
+    }
+
+  private:
+    const FieldTable<T, N>& table_;
+    Napi::Env env_;
+    // The indices in the table of the selected fields, and their keys.
+    std::array<size_t, N> selected_;
+    std::array<napi_value, N> keys_;
+    size_t n_ = 0;
+};
+
+template <typename T, size_t N>
+struct FieldTable {
+    static_assert(N <= 64, "FieldTable supports up to 64 fields");
+
+    std::array<Field<T>, N> fields;
+
+    // Returns the mask for a JS projection argument: an array of field names, or undefined/null
+    // for all the fields.  Throws on anything else, including unknown field names.
+    FieldMask mask_from_JS(const Napi::Value& val) const {
+        if (val.IsUndefined() || val.IsNull())
+            return ALL_FIELDS;
+        if (!val.IsArray())
+            throw std::invalid_argument{"fields projection must be an array of field names"};
+
+        auto arr = val.As<Napi::Array>();
+        FieldMask mask = 0;
+        for (uint32_t i = 0; i < arr.Length(); i++) {
+            Napi::Value name = arr.Get(i);
+            if (!name.IsString())
+                throw std::invalid_argument{"fields projection must be an array of field names"};
+            mask |= FieldMask{1} << index_of(name.As<Napi::String>().Utf8Value());
+        }
+        return mask;
+    }
+
+    // Returns the converter of the fields selected by `mask`, for converting many entities.
+    FieldConverter<T, N> converter(const Napi::Env& env, FieldMask mask = ALL_FIELDS) const {
+        return {*this, env, mask};
+    }
+
+    // Converts the fields of `val` selected by `mask`.
+    Napi::Object to_js(const Napi::Env& env, const T& val, FieldMask mask = ALL_FIELDS) const {
+        return converter(env, mask)(val);
+    }
+
+    size_t index_of(std::string_view name) const {
+        for (size_t i = 0; i < N; i++)
+            if (name == fields[i].name)
+                return i;
+        throw std::invalid_argument{"Unknown field in projection: " + std::string{name}};
+    }
+};
+
+// Builds a FieldTable<T, N> from a braced list of N {name, getter} fields.  The getters are
+// typically captureless lambdas returning Napi::Value.
+template <typename T, size_t N>
+constexpr FieldTable<T, N> field_table(const Field<T> (&fields)[N]) {
+    return {std::to_array(fields)};
+}
+
+// Specialize with `static constexpr const auto& fields = <the FieldTable of T>;` to make
+// get_all_impl() take an optional projection argument for T.
+template <typename T>
+struct entity_fields;
+
+template <typename T, typename = void>
+inline constexpr bool has_entity_fields = false;
+template <typename T>
+inline constexpr bool has_entity_fields<T, std::void_t<decltype(entity_fields<T>::fields)>> = true;
+
+}  // namespace session::nodeapi
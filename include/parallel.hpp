@@ -0,0 +1,59 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <thread>
+
+namespace session::nodeapi {
+
+// Upper bound on the number of threads (including the calling one) a single parallel_for uses.
+// Keeps one large batch from monopolizing the machine; the calling thread is typically a libuv
+// threadpool thread, so other async jobs are already competing for cores.
+inline constexpr unsigned PARALLEL_MAX_THREADS = 8;
+
+// Batches smaller than this are run inline on the calling thread: the per-item work we do is a few
+// tens of microseconds, so below this starting threads costs more than it saves.
+inline constexpr size_t PARALLEL_MIN_ITEMS = 8;
+
+// How many threads parallel_for will use for `count` items.
+inline unsigned parallel_thread_count(size_t count, size_t min_items = PARALLEL_MIN_ITEMS) {
+    if (count < std::max<size_t>(min_items, 2))
+        return 1;
+    unsigned hw = std::max(std::thread::hardware_concurrency(), 1u);
+    return static_cast<unsigned>(std::min<size_t>({hw, PARALLEL_MAX_THREADS, count}));
+}
+
+// The non-template part of parallel_for(): runs `fn` over [0, count) on the calling thread and
+// up to `nthreads - 1` helpers of the shared pool.
+void parallel_for_impl(size_t count, unsigned nthreads, const std::function<void(size_t)>& fn);
+
+/// Calls `fn(i)` for each `i` in [0, count), spread across up to parallel_thread_count(count)
+/// threads (the calling thread included), and returns once every call has completed.  Batches of
+/// fewer than `min_items` run inline: callers with much heavier items than the usual ones can lower
+/// it.
+///
+/// The other threads are helpers of a single process-wide pool, started on first use and sized to
+/// the hardware threads, so concurrent parallel_for calls (e.g. from several libuv threadpool jobs)
+/// share them rather than each starting their own.  The calling thread works through the items
+/// too, so a call makes progress even when every helper is busy with other calls.
+///
+/// Indices are handed out one at a time from a shared counter, so uneven per-item costs balance
+/// out.  `fn` must be safe to call concurrently for distinct indices; writing to slot `i` of a
+/// pre-sized output vector is the intended way of preserving input order.
+///
+/// If `fn` throws, no further indices are started and the first exception is rethrown here once
+/// all threads have stopped.  Callers wanting "skip and carry on" semantics should catch inside
+/// `fn`.
+template <typename Fn>
+void parallel_for(size_t count, Fn&& fn, size_t min_items = PARALLEL_MIN_ITEMS) {
+    unsigned nthreads = parallel_thread_count(count, min_items);
+    if (nthreads <= 1) {
+        for (size_t i = 0; i < count; i++)
+            fn(i);
+        return;
+    }
+    parallel_for_impl(count, nthreads, std::ref(fn));
+}
+
+}  // namespace session::nodeapi
@@ -11,12 +11,14 @@ namespace session::nodeapi {
 
 class UserConfigWrapper : public ConfigBaseImpl, public Napi::ObjectWrap<UserConfigWrapper> {
   public:
+    static constexpr const char* CLASS_NAME = "UserConfigWrapper";
+
     static void Init(Napi::Env env, Napi::Object exports);
 
     explicit UserConfigWrapper(const Napi::CallbackInfo& info);
 
   private:
-    config::UserProfile& config{get_config<config::UserProfile>()};
+    config::UserProfile& config() { return get_config<config::UserProfile>(); }
 
     Napi::Value getPriority(const Napi::CallbackInfo& info);
     Napi::Value getName(const Napi::CallbackInfo& info);
@@ -9,12 +9,14 @@ namespace session::nodeapi {
 
 class UserGroupsWrapper : public ConfigBaseImpl, public Napi::ObjectWrap<UserGroupsWrapper> {
   public:
+    static constexpr const char* CLASS_NAME = "UserGroupsWrapper";
+
     static void Init(Napi::Env env, Napi::Object exports);
 
     explicit UserGroupsWrapper(const Napi::CallbackInfo& info);
 
   private:
-    config::UserGroups& config{get_config<config::UserGroups>()};
+    config::UserGroups& config() { return get_config<config::UserGroups>(); }
 
     // Communities related methods
     Napi::Value getCommunityByFullUrl(const Napi::CallbackInfo& info);
@@ -38,6 +40,10 @@ class UserGroupsWrapper : public ConfigBaseImpl, public Napi::ObjectWrap<UserGro
     Napi::Value markGroupInvited(const Napi::CallbackInfo& info);
     Napi::Value markGroupDestroyed(const Napi::CallbackInfo& info);
     Napi::Value eraseGroup(const Napi::CallbackInfo& info);
+
+    // iterate({type, batchSize?, fields?}): a ConfigCursor over the communities, legacy groups or
+    // groups (`type` "community", "legacyGroup" or "group").
+    Napi::Value iterate(const Napi::CallbackInfo& info);
 };
 
 }  // namespace session::nodeapi
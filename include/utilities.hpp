@@ -5,6 +5,7 @@
 
 #include <chrono>
 #include <optional>
+#include <source_location>
 #include <span>
 #include <stdexcept>
 #include <string_view>
@@ -12,6 +13,8 @@
 #include <unordered_set>
 #include <vector>
 
+#include "instrumentation.hpp"
+#include "object_shape.hpp"
 #include "oxen/log/catlogger.hpp"
 #include "oxenc/base64.h"
 #include "oxenc/hex.h"
@@ -134,6 +137,23 @@ auto toJs(const Napi::Env& env, const T& val) {
     return toJs_impl<T>{}(env, val);
 }
 
+// Overload for temporaries: the value is passed on as an rvalue so that converters able to take
+// ownership of it (e.g. a byte vector handed over to an external Buffer) can do so instead of
+// copying.  Converters only taking a const reference are unaffected.
+template <typename T, std::enable_if_t<!std::is_lvalue_reference_v<T>, int> = 0>
+auto toJs(const Napi::Env& env, T&& val) {
+    return toJs_impl<std::remove_cv_t<T>>{}(env, std::move(val));
+}
+
+// Byte payloads smaller than this are copied into a new Buffer even when we own the vector: an
+// external Buffer costs a heap-allocated owner and a GC finalizer, which outweighs a small memcpy.
+inline constexpr size_t EXTERNAL_BUFFER_MIN_SIZE = 4096;
+
+// Converts an owned byte vector into a Buffer, handing the vector's storage over to JS (freed
+// once the Buffer is garbage collected) rather than copying it if it is at least
+// EXTERNAL_BUFFER_MIN_SIZE bytes.
+Napi::Buffer<uint8_t> toJsBuffer(const Napi::Env& env, std::vector<unsigned char>&& b);
+
 template <>
 struct toJs_impl<bool> {
     auto operator()(const Napi::Env& env, bool b) const { return Napi::Boolean::New(env, b); }
@@ -170,6 +190,7 @@ struct toJs_impl<
                 std::is_convertible_v<T, std::span<const unsigned char>> &&
                 !std::is_same_v<std::remove_cv_t<T>, std::vector<unsigned char>>>> {
     auto operator()(const Napi::Env& env, std::span<const unsigned char> b) const {
+        instrumentation::count_bytes_out(b.size());
         return Napi::Buffer<uint8_t>::Copy(env, b.data(), b.size());
     }
 };
@@ -177,15 +198,20 @@ struct toJs_impl<
 // this wrap std::vector<unsigned char> to Uint8array in the js world
 template <>
 struct toJs_impl<std::vector<unsigned char>> {
-    auto operator()(const Napi::Env& env, std::vector<unsigned char> b) const {
+    auto operator()(const Napi::Env& env, const std::vector<unsigned char>& b) const {
+        instrumentation::count_bytes_out(b.size());
         return Napi::Buffer<uint8_t>::Copy(env, b.data(), b.size());
     }
+    auto operator()(const Napi::Env& env, std::vector<unsigned char>&& b) const {
+        return toJsBuffer(env, std::move(b));
+    }
 };
 
 // this wrap std::vector<std::byte> to Uint8array in the js world
 template <>
 struct toJs_impl<std::vector<std::byte>> {
     auto operator()(const Napi::Env& env, std::vector<std::byte> b) const {
+        instrumentation::count_bytes_out(b.size());
         return Napi::Buffer<uint8_t>::Copy(
                 env, reinterpret_cast<const unsigned char*>(b.data()), b.size());
     }
@@ -196,6 +222,7 @@ template <std::size_t N>
 struct toJs_impl<std::array<std::byte, N>> {
     auto operator()(const Napi::Env& env, const std::array<std::byte, N>& b) const {
         const auto* data_uchar = reinterpret_cast<const uint8_t*>(b.data());
+        instrumentation::count_bytes_out(b.size());
         return Napi::Buffer<uint8_t>::Copy(env, data_uchar, b.size());
     }
 };
@@ -211,6 +238,7 @@ struct toJs_impl<std::span<std::byte>> {
         // through this template — but one accidental toJs() would
         // SIGSEGV the Node process.
         auto data_uchar = reinterpret_cast<const unsigned char*>(b.data());
+        instrumentation::count_bytes_out(b.size());
         return Napi::Buffer<uint8_t>::Copy(env, data_uchar, b.size());
     }
 };
@@ -228,6 +256,12 @@ struct toJs_impl<std::vector<T>> {
             arr[i] = toJs(env, val[i]);
         return arr;
     }
+    auto operator()(const Napi::Env& env, std::vector<T>&& val) {
+        auto arr = Napi::Array::New(env, val.size());
+        for (size_t i = 0; i < val.size(); i++)
+            arr[i] = toJs(env, std::move(val[i]));
+        return arr;
+    }
 };
 
 template <typename T>
@@ -288,32 +322,39 @@ inline auto toJsMs(const Napi::Env& env, std::chrono::milliseconds d) {
 
 // Returns {"url": "...", "key": buffer} object; both values will be Null if the pic is not set.
 
+inline constexpr ObjectShape profile_pic_shape{"url", "key"};
+
 template <>
 struct toJs_impl<config::profile_pic> {
     auto operator()(const Napi::Env& env, const config::profile_pic& pic) const {
-        auto obj = Napi::Object::New(env);
-        if (pic) {
-            obj["url"] = toJs(env, pic.url);
-            obj["key"] = toJs(env, pic.key);
-        } else {
-            obj["url"] = env.Null();
-            obj["key"] = env.Null();
-        }
-        return obj;
+        if (pic)
+            return profile_pic_shape.make(env, toJs(env, pic.url), toJs(env, pic.key));
+        return profile_pic_shape.make(env, env.Null(), env.Null());
     }
 };
 
 // Helper for various "get_all" functions that copy [it...end) into a Napi::Array via toJs().
+// For entity types with a FieldTable (see entity_fields), the JS call can pass an optional array
+// of field names as projection, and only those fields are converted.
 // Throws a Napi::Error on any exception.
 template <typename It, typename EndIt>
 static Napi::Array get_all_impl(const Napi::CallbackInfo& info, size_t size, It it, EndIt end) {
     auto env = info.Env();
     return wrapResult(env, [&] {
-        assertInfoLength(info, 0);
+        using T = std::remove_cvref_t<decltype(*it)>;
         auto result = Napi::Array::New(env, size);
         int i = 0;
-        for (; it != end; it++)
-            result[i++] = toJs(env, *it);
+        if constexpr (has_entity_fields<T>) {
+            checkOrThrow(info.Length() <= 1, "Invalid number of arguments");
+            const auto& table = entity_fields<T>::fields;
+            auto convert = table.converter(env, table.mask_from_JS(info[0]));
+            for (; it != end; it++)
+                result[i++] = convert(*it);
+        } else {
+            assertInfoLength(info, 0);
+            for (; it != end; it++)
+                result[i++] = toJs(env, *it);
+        }
 
         return result;
     });
@@ -340,9 +381,16 @@ inline std::optional<std::string_view> maybe_string(std::string_view val) {
 //
 //     return wrapResult(env, [&] { return foo(); });
 //
+// Calls `call()`, converting its result to JS via toJs() and rethrowing any std::exception as a
+// Napi::Error.  `loc` identifies the calling method for the (opt-in) instrumentation, and should
+// be left to its default.
 template <typename Call>
-auto wrapResult(const Napi::Env& env, Call&& call) {
+auto wrapResult(
+        const Napi::Env& env,
+        Call&& call,
+        const std::source_location& loc = std::source_location::current()) {
     using Result = decltype(call());
+    instrumentation::CallScope scope{loc};
     try {
         if constexpr (std::is_void_v<Result>) {
             call();
@@ -361,14 +409,21 @@ auto wrapResult(const Napi::Env& env, Call&& call) {
 // Similar to wrapResult(), but a small shortcut to allow passing `info` instead of `info.Env()`
 // as the first argument.
 template <typename Call>
-auto wrapResult(const Napi::CallbackInfo& info, Call&& call) {
-    return wrapResult(info.Env(), std::forward<Call>(call));
+auto wrapResult(
+        const Napi::CallbackInfo& info,
+        Call&& call,
+        const std::source_location& loc = std::source_location::current()) {
+    return wrapResult(info.Env(), std::forward<Call>(call), loc);
 }
 
 // Similar to wrapResult(), but this only applies the exception wrapping (i.e. no wrapping of
 // the result: we return it exactly as-is).
 template <typename Call>
-auto wrapExceptions(const Napi::Env& env, Call&& call) {
+auto wrapExceptions(
+        const Napi::Env& env,
+        Call&& call,
+        const std::source_location& loc = std::source_location::current()) {
+    instrumentation::CallScope scope{loc};
     try {
         return call();
     } catch (const std::exception& e) {
@@ -376,8 +431,11 @@ auto wrapExceptions(const Napi::Env& env, Call&& call) {
     }
 }
 template <typename Call>
-auto wrapExceptions(const Napi::CallbackInfo& info, Call&& call) {
-    return wrapExceptions(info.Env(), std::forward<Call>(call));
+auto wrapExceptions(
+        const Napi::CallbackInfo& info,
+        Call&& call,
+        const std::source_location& loc = std::source_location::current()) {
+    return wrapExceptions(info.Env(), std::forward<Call>(call), loc);
 }
 
 std::string printable(std::string_view x);
@@ -406,7 +464,7 @@ using confirm_pushed_entry_t =
 
 Napi::Object push_result_to_JS(
         const Napi::Env& env,
-        const push_entry_t& push_entry,
+        push_entry_t push_entry,
         const session::config::Namespace& push_namespace);
 
 Napi::Object push_key_entry_to_JS(
@@ -419,6 +477,27 @@ Napi::Object decrypt_result_to_JS(
 
 confirm_pushed_entry_t confirm_pushed_entry_from_JS(const Napi::Env& env, const Napi::Object& obj);
 
+// (hash, data) pairs parsed from a `[{hash, data}, ...]` JS array, in the form ConfigBase::merge
+// takes them.  Each data span either borrows the memory of the JS Uint8Array, and so is only valid
+// until the current synchronous call returns to JS, or (when added with `copy` set, e.g. for the
+// input of an async job) points into `owned`.  Moving a vector keeps its heap buffer, so those
+// spans stay valid when this is moved around.
+struct merge_entries {
+    std::vector<std::pair<std::string, std::span<const unsigned char>>> configs;
+    std::vector<std::vector<unsigned char>> owned;
+
+    merge_entries() = default;
+    // A copy would carry spans into the original's `owned` buffers, so only allow moves.
+    merge_entries(const merge_entries&) = delete;
+    merge_entries& operator=(const merge_entries&) = delete;
+    merge_entries(merge_entries&&) = default;
+    merge_entries& operator=(merge_entries&&) = default;
+
+    void add(std::string hash, const Napi::Value& data, bool copy, const std::string& identifier);
+    bool empty() const { return configs.empty(); }
+    size_t size() const { return configs.size(); }
+};
+
 Napi::BigInt proProfileBitsetToJS(const Napi::Env& env, const ProProfileBitset bitset);
 
 Napi::BigInt proMessageBitsetToJS(const Napi::Env& env, const ProMessageBitset bitset);
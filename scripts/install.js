@@ -14,6 +14,7 @@ const result = spawnSync(
     '--CDLOCAL_MIRROR=https://oxen.rocks/deps',
     '--CDENABLE_NETWORKING=OFF',
     '--CDWITH_TESTS=OFF',
+    `--CDLIBSESSION_NODEJS_BENCH=${process.env.LIBSESSION_NODEJS_BENCH ? 'ON' : 'OFF'}`,
   ],
   { stdio: 'inherit', shell: true },
 )
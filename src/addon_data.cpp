@@ -0,0 +1,36 @@
+#include "addon_data.hpp"
+
+#include <napi.h>
+
+#include <stdexcept>
+
+namespace session::nodeapi {
+
+AddonData& AddonData::get(Napi::Env env) {
+    auto* data = env.GetInstanceData<AddonData>();
+    if (!data) {
+        data = new AddonData{env};
+        env.SetInstanceData(data);
+    }
+    return *data;
+}
+
+void AddonData::add_constructor(const char* class_name, Napi::Function cls) {
+    constructors_[class_name] = Napi::Persistent(cls);
+}
+
+Napi::Function AddonData::constructor(const std::string& class_name) const {
+    auto it = constructors_.find(class_name);
+    if (it == constructors_.end())
+        throw std::logic_error{"No constructor registered for " + class_name};
+    return it->second.Value();
+}
+
+Napi::String AddonData::interned(const char* literal) {
+    auto [it, inserted] = interned_.try_emplace(literal);
+    if (inserted)
+        it->second = Napi::Persistent(Napi::String::New(env_, literal));
+    return it->second.Value();
+}
+
+}  // namespace session::nodeapi
@@ -1,20 +1,41 @@
 #include "base_config.hpp"
 
+#include "async_worker.hpp"
+#include "change_set.hpp"
+#include "object_shape.hpp"
 #include "session/config/base.hpp"
 
 namespace session::nodeapi {
 
 using config::ConfigBase;
 
+config_args config_args_from_JS(const Napi::CallbackInfo& info, const std::string& identifier) {
+    assertInfoLength(info, 2);
+
+    // we should get secret key as first arg and optional dumped as second argument
+    assertIsUInt8Array(info[0], identifier);
+    assertIsUInt8ArrayOrNull(info[1]);
+    config_args args;
+    args.secret_key = toCppBuffer(info[0], identifier);
+
+    auto second = info[1];
+    if (!second.IsEmpty() && !second.IsNull() && !second.IsUndefined())
+        args.dump = toCppBuffer(second, identifier);
+    return args;
+}
+
 Napi::Value ConfigBaseImpl::needsDump(const Napi::CallbackInfo& info) {
+    instrumentation::ClassScope scope{class_name_};
     return wrapResult(info, [&] { return get_config<ConfigBase>().needs_dump(); });
 }
 
 Napi::Value ConfigBaseImpl::needsPush(const Napi::CallbackInfo& info) {
+    instrumentation::ClassScope scope{class_name_};
     return wrapResult(info, [&] { return get_config<ConfigBase>().needs_push(); });
 }
 
 Napi::Value ConfigBaseImpl::activeHashes(const Napi::CallbackInfo& info) {
+    instrumentation::ClassScope scope{class_name_};
     return wrapResult(info, [&] {
         std::unordered_set<std::string> hashes = get_config<ConfigBase>().active_hashes();
         std::vector<std::string> hashesVec(hashes.begin(), hashes.end());
@@ -23,16 +44,19 @@ Napi::Value ConfigBaseImpl::activeHashes(const Napi::CallbackInfo& info) {
 }
 
 Napi::Value ConfigBaseImpl::push(const Napi::CallbackInfo& info) {
+    instrumentation::ClassScope scope{class_name_};
     return wrapResult(info, [&]() {
         assertInfoLength(info, 0);
         auto& conf = get_config<ConfigBase>();
+        mutated();
         auto to_push = conf.push();
 
-        return push_result_to_JS(info.Env(), to_push, conf.storage_namespace());
+        return push_result_to_JS(info.Env(), std::move(to_push), conf.storage_namespace());
     });
 }
 
 Napi::Value ConfigBaseImpl::dump(const Napi::CallbackInfo& info) {
+    instrumentation::ClassScope scope{class_name_};
     return wrapResult(info, [&]() {
         assertInfoLength(info, 0);
         return get_config<ConfigBase>().dump();
@@ -40,6 +64,7 @@ Napi::Value ConfigBaseImpl::dump(const Napi::CallbackInfo& info) {
 }
 
 Napi::Value ConfigBaseImpl::makeDump(const Napi::CallbackInfo& info) {
+    instrumentation::ClassScope scope{class_name_};
     return wrapResult(info, [&]() {
         assertInfoLength(info, 0);
         return get_config<ConfigBase>().make_dump();
@@ -47,40 +72,124 @@ Napi::Value ConfigBaseImpl::makeDump(const Napi::CallbackInfo& info) {
 }
 
 void ConfigBaseImpl::confirmPushed(const Napi::CallbackInfo& info) {
+    instrumentation::ClassScope scope{class_name_};
     return wrapExceptions(info, [&]() {
         assertInfoLength(info, 1);
         assertIsObject(info[0]);
         auto obj = info[0].As<Napi::Object>();
         auto confirmed_pushed_entry = confirm_pushed_entry_from_JS(info.Env(), obj);
 
+        mutated();
         get_config<ConfigBase>().confirm_pushed(
                 std::get<0>(confirmed_pushed_entry), std::get<1>(confirmed_pushed_entry));
     });
 }
 
+merge_entries merge_entries_from_JS(
+        const Napi::Value& val, const std::string& identifier, bool copy) {
+    assertIsArray(val, identifier);
+    Napi::Array asArray = val.As<Napi::Array>();
+
+    merge_entries entries;
+    entries.configs.reserve(asArray.Length());
+    if (copy)
+        entries.owned.reserve(asArray.Length());
+
+    for (uint32_t i = 0; i < asArray.Length(); i++) {
+        Napi::Value item = asArray[i];
+        assertIsObject(item);
+        if (item.IsEmpty())
+            throw std::invalid_argument("Merge.item received empty");
+
+        Napi::Object itemObject = item.As<Napi::Object>();
+        entries.add(
+                toCppString(itemObject.Get("hash"), identifier),
+                itemObject.Get("data"),
+                copy,
+                identifier);
+    }
+    return entries;
+}
+
+// The outcome of merge() and mergeAsync(): the merged hashes, and the change set if requested.
+struct merge_result {
+    std::vector<std::string> merged;
+    std::optional<config_changes> changes;
+};
+
+// Merges `entries` into `conf`, and computes the change set if `with_changes`.  Touches no JS
+// value, so this can run off the main thread.
+static merge_result merge_config(
+        ConfigBase& conf,
+        config_fingerprinter fingerprints,
+        const merge_entries& entries,
+        bool with_changes) {
+    std::optional<config_fingerprints> before;
+    if (with_changes)
+        before = fingerprints(conf);
+
+    std::unordered_set<std::string> merged = conf.merge(entries.configs);
+    merge_result result{{merged.begin(), merged.end()}};
+
+    // Computed natively from the fingerprints of the entries before and after the merge, which is
+    // much cheaper than fetching everything again from JS to diff it there.
+    if (with_changes)
+        result.changes = diff_fingerprints(*before, fingerprints(conf));
+    return result;
+}
+
+static constexpr ObjectShape merge_result_shape{"merged", "changes"};
+
+static Napi::Value merge_result_to_JS(const Napi::Env& env, const merge_result& result) {
+    if (!result.changes)
+        return toJs(env, result.merged);
+    return merge_result_shape.make(env, toJs(env, result.merged), toJs(env, *result.changes));
+}
+
 Napi::Value ConfigBaseImpl::merge(const Napi::CallbackInfo& info) {
+    instrumentation::ClassScope scope{class_name_};
     return wrapResult(info, [&]() {
-        assertInfoLength(info, 1);
-        assertIsArray(info[0], "ConfigBaseImpl::merge");
-        Napi::Array asArray = info[0].As<Napi::Array>();
-
-        std::vector<std::pair<std::string, std::vector<unsigned char>>> conf_strs;
-        conf_strs.reserve(asArray.Length());
-
-        for (uint32_t i = 0; i < asArray.Length(); i++) {
-            Napi::Value item = asArray[i];
-            assertIsObject(item);
-            if (item.IsEmpty())
-                throw std::invalid_argument("Merge.item received empty");
-
-            Napi::Object itemObject = item.As<Napi::Object>();
-            conf_strs.emplace_back(
-                    toCppString(itemObject.Get("hash"), "base.merge"),
-                    toCppBuffer(itemObject.Get("data"), "base.merge"));
-        }
-        std::unordered_set<std::string> merged = get_config<ConfigBase>().merge(conf_strs);
-        std::vector<std::string> mergedVec(merged.begin(), merged.end());
-        return mergedVec;
+        checkOrThrow(info.Length() >= 1 && info.Length() <= 2, "Invalid number of arguments");
+        auto entries = merge_entries_from_JS(info[0], "ConfigBaseImpl::merge", false);
+        bool with_changes = change_set_requested(info[1]);
+
+        auto& conf = get_config<ConfigBase>();
+        mutated();
+        return merge_result_to_JS(
+                info.Env(), merge_config(conf, fingerprints_, entries, with_changes));
+    });
+}
+
+Napi::Value ConfigBaseImpl::mergeAsync(const Napi::CallbackInfo& info) {
+    instrumentation::ClassScope scope{class_name_};
+    return wrapResult(info, [&]() {
+        checkOrThrow(info.Length() >= 1 && info.Length() <= 2, "Invalid number of arguments");
+        auto entries = merge_entries_from_JS(info[0], "ConfigBaseImpl::mergeAsync", true);
+        bool with_changes = change_set_requested(info[1]);
+        assertNotBusy();
+
+        // The inputs are owned copies and the job holds its own reference to the config, so
+        // nothing here depends on JS values once queued; the change set, if requested, is computed
+        // by the job too, as the config is its own until then.  The wrapper refuses any other
+        // access to the config (including another mergeAsync) until the job settles.
+        auto* worker = makePromiseWorker(
+                info.Env(),
+                "ConfigBaseImpl::mergeAsync",
+                [conf = conf_,
+                 fingerprints = fingerprints_,
+                 entries = std::move(entries),
+                 with_changes] {
+                    return merge_config(*conf, fingerprints, entries, with_changes);
+                },
+                [](const Napi::Env& env, const merge_result& result) {
+                    return merge_result_to_JS(env, result);
+                });
+        worker->OnSettled([this] { busy_ = false; });
+        worker->KeepAlive(info.This().As<Napi::Object>());
+
+        busy_ = true;
+        mutated();
+        return worker->QueuePromise();
     });
 }
 
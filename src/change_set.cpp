@@ -0,0 +1,79 @@
+#include "change_set.hpp"
+
+#include <napi.h>
+
+#include <algorithm>
+
+#include "object_shape.hpp"
+
+namespace session::nodeapi {
+
+void Fingerprint::add_bytes(const void* data, size_t size) {
+    auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash_ ^= bytes[i];
+        hash_ *= 0x100000001b3;
+    }
+}
+
+change_set diff_fingerprints(const entry_fingerprints& before, const entry_fingerprints& after) {
+    change_set changes;
+    for (const auto& [key, fp] : after) {
+        auto it = before.find(key);
+        if (it == before.end())
+            changes.added.push_back(key);
+        else if (it->second != fp)
+            changes.updated.push_back(key);
+    }
+    for (const auto& [key, fp] : before)
+        if (!after.contains(key))
+            changes.removed.push_back(key);
+
+    std::ranges::sort(changes.added);
+    std::ranges::sort(changes.updated);
+    std::ranges::sort(changes.removed);
+    return changes;
+}
+
+config_changes diff_fingerprints(
+        const config_fingerprints& before, const config_fingerprints& after) {
+    static const entry_fingerprints none;
+    config_changes changes;
+    for (const auto& [collection, fps] : before) {
+        auto it = after.find(collection);
+        changes[collection] = diff_fingerprints(fps, it != after.end() ? it->second : none);
+    }
+    for (const auto& [collection, fps] : after)
+        if (!before.contains(collection))
+            changes[collection] = diff_fingerprints(none, fps);
+    return changes;
+}
+
+bool change_set_requested(const Napi::Value& options) {
+    if (options.IsUndefined() || options.IsNull())
+        return false;
+    assertIsObject(options);
+    return maybeNonemptyBoolean(options.As<Napi::Object>().Get("changeSet"), "merge changeSet")
+            .value_or(false);
+}
+
+static constexpr ObjectShape change_set_shape{"added", "updated", "removed"};
+
+Napi::Object toJs_impl<change_set>::operator()(
+        const Napi::Env& env, const change_set& changes) const {
+    return change_set_shape.make(
+            env,
+            toJs(env, changes.added),
+            toJs(env, changes.updated),
+            toJs(env, changes.removed));
+}
+
+Napi::Object toJs_impl<config_changes>::operator()(
+        const Napi::Env& env, const config_changes& changes) const {
+    auto obj = Napi::Object::New(env);
+    for (const auto& [collection, change] : changes)
+        obj.Set(collection, toJs(env, change));
+    return obj;
+}
+
+}  // namespace session::nodeapi
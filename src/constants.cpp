@@ -2,6 +2,7 @@
 
 #include <oxenc/hex.h>
 
+#include "groups/member_status_index.hpp"
 #include "js_native_api_types.h"
 #include "session/config/contacts.hpp"
 #include "session/config/groups/info.hpp"
@@ -31,6 +32,11 @@ Napi::Object ConstantsWrapper::Init(Napi::Env env, Napi::Object exports) {
     // per-provider support/management URLs are still libsession-owned but are now fetched on demand
     // via ProWrapper.providerUrls(code) rather than baked into a constants table here.
 
+    // The codes of the member statuses, as returned by MetaGroupWrapper.memberGetAllCompact()
+    auto member_statuses = Napi::Object::New(env);
+    for (size_t i = 0; i < all_member_statuses.size(); i++)
+        member_statuses[member_status_string(all_member_statuses[i])] = toJs(env, i);
+
     // construct javascript constants object
     Napi::Function cls = DefineClass(
             env,
@@ -65,6 +71,7 @@ Napi::Object ConstantsWrapper::Init(Napi::Env env, Napi::Object exports) {
                      "MESSAGE_CHARACTER_LIMIT_PRO",
                      Napi::Number::New(env, SESSION_PROTOCOL_PRO_HIGHER_CHARACTER_LIMIT),
                      napi_enumerable),
+             ObjectWrap::StaticValue("MEMBER_STATUS", member_statuses, napi_enumerable),
              ObjectWrap::StaticValue("LIBSESSION_PRO_URLS", pro_urls, napi_enumerable),
              // Session Pro backend identity — the single source of truth clients read instead of
              // hand-carrying their own copies (URL is the overridable prod/default; pubkey is hex).
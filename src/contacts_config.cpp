@@ -1,7 +1,15 @@
 #include "contacts_config.hpp"
 
+#include <oxenc/hex.h>
+
+#include <algorithm>
+#include <iterator>
 #include <optional>
+#include <string_view>
+#include <utility>
 
+#include "cursor.hpp"
+#include "object_shape.hpp"
 #include "profile_pic.hpp"
 #include "session/config/expiring.hpp"
 #include "session/types.hpp"
@@ -35,45 +43,78 @@ inline constexpr expiration_mode expiration_mode_from_string(std::string_view mo
     return expiration_mode::none;
 }
 
+// The fields of the objects contacts convert to; getAll() can be given a subset of their names.
+static constexpr auto contact_fields = field_table<contact_info>({
+        {"id", [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.session_id); }},
+        {"name", [](auto& env, auto& c) -> Napi::Value { return toJs(env, maybe_string(c.name)); }},
+        {"nickname",
+         [](auto& env, auto& c) -> Napi::Value { return toJs(env, maybe_string(c.nickname)); }},
+        {"approved", [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.approved); }},
+        {"approvedMe", [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.approved_me); }},
+        {"profileUpdatedSeconds",
+         [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.profile_updated); }},
+        {"blocked", [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.blocked); }},
+        {"priority", [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.priority); }},
+        {"createdAtSeconds",
+         [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.created); }},
+        {"expirationMode",
+         [](auto& env, auto& c) -> Napi::Value {
+             return toJs(env, expiration_mode_string(c.exp_mode));
+         }},
+        {"expirationTimerSeconds",
+         [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.exp_timer.count()); }},
+        {"profilePicture",
+         [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.profile_picture); }},
+        {"proProfileBitset",
+         [](auto& env, auto& c) -> Napi::Value {
+             return proProfileBitsetToJS(env, c.profile_bitset);
+         }},
+});
+
 template <>
-struct toJs_impl<contact_info> {
-    Napi::Object operator()(const Napi::Env& env, const contact_info& contact) {
-        auto obj = Napi::Object::New(env);
-
-        obj["id"] = toJs(env, contact.session_id);
-        obj["name"] = toJs(env, maybe_string(contact.name));
-        obj["nickname"] = toJs(env, maybe_string(contact.nickname));
-        obj["approved"] = toJs(env, contact.approved);
-        obj["approvedMe"] = toJs(env, contact.approved_me);
-        obj["profileUpdatedSeconds"] = toJs(env, contact.profile_updated);
-        obj["blocked"] = toJs(env, contact.blocked);
-        obj["priority"] = toJs(env, contact.priority);
-        obj["createdAtSeconds"] = toJs(env, contact.created);
-        obj["expirationMode"] = toJs(env, expiration_mode_string(contact.exp_mode));
-        obj["expirationTimerSeconds"] = toJs(env, contact.exp_timer.count());
-        obj["profilePicture"] = toJs(env, contact.profile_picture);
-        obj["proProfileBitset"] = proProfileBitsetToJS(env, contact.profile_bitset);
-
-        return obj;
-    }
+struct entity_fields<contact_info> {
+    static constexpr const auto& fields = contact_fields;
 };
 
+Napi::Object toJs_impl<contact_info>::operator()(
+        const Napi::Env& env, const contact_info& contact) const {
+    return contact_fields.to_js(env, contact);
+}
+
 void ContactsConfigWrapper::Init(Napi::Env env, Napi::Object exports) {
     InitHelper<ContactsConfigWrapper>(
             env,
             exports,
             "ContactsConfigWrapperNode",
             {
+                    StaticMethod<&createAsync<ContactsConfigWrapper, Contacts>>("createAsync"),
                     InstanceMethod("get", &ContactsConfigWrapper::get),
                     InstanceMethod("getAll", &ContactsConfigWrapper::getAll),
+                    InstanceMethod("getAllColumnar", &ContactsConfigWrapper::getAllColumnar),
+                    InstanceMethod("iterate", &ContactsConfigWrapper::iterate),
                     InstanceMethod("set", &ContactsConfigWrapper::set),
                     InstanceMethod("erase", &ContactsConfigWrapper::erase),
 
             });
 }
 
+// The key and fingerprint of a contact, for the change sets of merge().
+static std::pair<std::string, uint64_t> contact_fingerprint(const contact_info& c) {
+    Fingerprint fp;
+    fp.add(c.name, c.nickname, c.approved, c.approved_me, c.blocked, c.priority, c.created);
+    fp.add(c.profile_updated, c.exp_mode, c.exp_timer);
+    fp.add(c.profile_picture.url, c.profile_picture.key, c.profile_bitset.data);
+    return {c.session_id, fp.value()};
+}
+
+// The collection fingerprints of a Contacts config (see config_fingerprinter).
+static config_fingerprints contacts_fingerprints(config::ConfigBase& base) {
+    auto& conf = static_cast<Contacts&>(base);
+    return {{"contact", fingerprint_all(conf.begin(), conf.end(), contact_fingerprint)}};
+}
+
 ContactsConfigWrapper::ContactsConfigWrapper(const Napi::CallbackInfo& info) :
-        ConfigBaseImpl{construct<Contacts>(info, "ContactsConfig")},
+        ConfigBaseImpl{construct<Contacts>(info, CLASS_NAME), CLASS_NAME, contacts_fingerprints},
         Napi::ObjectWrap<ContactsConfigWrapper>{info} {}
 
 /** ==============================
@@ -82,22 +123,183 @@ ContactsConfigWrapper::ContactsConfigWrapper(const Napi::CallbackInfo& info) :
 
 Napi::Value ContactsConfigWrapper::get(const Napi::CallbackInfo& info) {
     auto env = info.Env();
-    return wrapResult(env, [&] { return config.get(getStringArgs<1>(info)); });
+    return wrapResult(env, [&] { return config().get(getStringArgs<1>(info)); });
 }
 
 Napi::Value ContactsConfigWrapper::getAll(const Napi::CallbackInfo& info) {
     auto env = info.Env();
     return wrapExceptions(env, [&] {
-        assertInfoLength(info, 0);
+        checkOrThrow(info.Length() <= 1, "Invalid number of arguments");
+        auto convert = contact_fields.converter(env, contact_fields.mask_from_JS(info[0]));
 
-        auto contacts = Napi::Array::New(env, config.size());
+        auto contacts = Napi::Array::New(env, config().size());
         size_t i = 0;
-        for (const auto& contact : config)
-            contacts[i++] = toJs(env, contact);
+        for (const auto& contact : config())
+            contacts[i++] = convert(contact);
         return contacts;
     });
 }
 
+Napi::Value ContactsConfigWrapper::iterate(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        checkOrThrow(info.Length() <= 1, "Invalid number of arguments");
+        auto opts = cursor_options_from_JS(info[0]);
+        if (opts.type)
+            throw std::invalid_argument{"iterate: contacts have no `type` to choose"};
+        auto& conf = config();
+        return make_entity_cursor(info, cursor_guard(), opts, conf.begin(), conf.end());
+    });
+}
+
+// The columns getAllColumnar() can return, as requested from JS.
+struct contact_columns {
+    bool id = false;
+    bool name = false;
+    bool nickname = false;
+    bool approved = false;
+    bool approved_me = false;
+    bool blocked = false;
+    bool priority = false;
+    bool created = false;
+    bool profile_updated = false;
+    bool expiration_mode = false;
+    bool expiration_timer = false;
+    bool pro_profile_bitset = false;
+};
+
+static contact_columns contact_columns_from_JS(const Napi::Value& val) {
+    static constexpr std::pair<std::string_view, bool contact_columns::*> names[] = {
+            {"id", &contact_columns::id},
+            {"name", &contact_columns::name},
+            {"nickname", &contact_columns::nickname},
+            {"approved", &contact_columns::approved},
+            {"approvedMe", &contact_columns::approved_me},
+            {"blocked", &contact_columns::blocked},
+            {"priority", &contact_columns::priority},
+            {"createdAtSeconds", &contact_columns::created},
+            {"profileUpdatedSeconds", &contact_columns::profile_updated},
+            {"expirationMode", &contact_columns::expiration_mode},
+            {"expirationTimerSeconds", &contact_columns::expiration_timer},
+            {"proProfileBitset", &contact_columns::pro_profile_bitset},
+    };
+
+    assertIsArray(val, "getAllColumnar fields");
+    auto arr = val.As<Napi::Array>();
+    contact_columns columns;
+    for (uint32_t i = 0; i < arr.Length(); i++) {
+        auto field = toCppString(arr.Get(i), "getAllColumnar fields");
+        auto it = std::find_if(std::begin(names), std::end(names), [&](const auto& n) {
+            return n.first == field;
+        });
+        if (it == std::end(names))
+            throw std::invalid_argument{"getAllColumnar: unsupported field " + field};
+        columns.*(it->second) = true;
+    }
+    return columns;
+}
+
+// The JS value of an expiration mode in the expirationMode column: the index of its string in
+// [off, deleteAfterRead, deleteAfterSend].
+static uint8_t expiration_mode_code(expiration_mode mode) {
+    switch (mode) {
+        case expiration_mode::none: return 0;
+        case expiration_mode::after_read: return 1;
+        case expiration_mode::after_send: return 2;
+    }
+    throw std::logic_error{"Internal error: unhandled expiration mode!"};
+}
+
+Napi::Value ContactsConfigWrapper::getAllColumnar(const Napi::CallbackInfo& info) {
+    auto env = info.Env();
+    return wrapExceptions(env, [&] {
+        assertInfoLength(info, 1);
+        auto columns = contact_columns_from_JS(info[0]);
+        auto& conf = config();
+        size_t count = conf.size();
+
+        auto result = Napi::Object::New(env);
+        result["count"] = toJs(env, count);
+
+        // Each helper allocates the column (zero-filled, as typed arrays are), adds it to the
+        // result and returns where to write its values, or nullptr if it wasn't requested.
+        auto u8_column = [&](bool wanted, const char* name, size_t size) -> uint8_t* {
+            if (!wanted)
+                return nullptr;
+            auto arr = Napi::Uint8Array::New(env, size);
+            result[name] = arr;
+            return arr.Data();
+        };
+        auto f64_column = [&](bool wanted, const char* name) -> double* {
+            if (!wanted)
+                return nullptr;
+            auto arr = Napi::Float64Array::New(env, count);
+            result[name] = arr;
+            return arr.Data();
+        };
+        auto string_column = [&](bool wanted, const char* name) -> std::optional<Napi::Array> {
+            if (!wanted)
+                return std::nullopt;
+            auto arr = Napi::Array::New(env, count);
+            result[name] = arr;
+            return arr;
+        };
+        size_t bitset_size = (count + 7) / 8;
+
+        uint8_t* ids = u8_column(columns.id, "id", count * 33);
+        auto names = string_column(columns.name, "name");
+        auto nicknames = string_column(columns.nickname, "nickname");
+        uint8_t* approved = u8_column(columns.approved, "approved", bitset_size);
+        uint8_t* approved_me = u8_column(columns.approved_me, "approvedMe", bitset_size);
+        uint8_t* blocked = u8_column(columns.blocked, "blocked", bitset_size);
+        double* priority = f64_column(columns.priority, "priority");
+        double* created = f64_column(columns.created, "createdAtSeconds");
+        double* profile_updated = f64_column(columns.profile_updated, "profileUpdatedSeconds");
+        uint8_t* exp_mode = u8_column(columns.expiration_mode, "expirationMode", count);
+        double* exp_timer = f64_column(columns.expiration_timer, "expirationTimerSeconds");
+        uint64_t* pro_bitset = nullptr;
+        if (columns.pro_profile_bitset) {
+            auto arr = Napi::BigUint64Array::New(env, count);
+            result["proProfileBitset"] = arr;
+            pro_bitset = arr.Data();
+        }
+
+        auto set_bit = [](uint8_t* bitset, size_t i, bool value) {
+            if (value)
+                bitset[i / 8] |= 1 << (i % 8);
+        };
+
+        size_t i = 0;
+        for (auto it = conf.begin(); it != conf.end() && i < count; ++it, ++i) {
+            const contact_info& c = *it;
+            if (ids)
+                oxenc::from_hex(c.session_id.begin(), c.session_id.end(), ids + i * 33);
+            if (names)
+                (*names)[i] = toJs(env, maybe_string(c.name));
+            if (nicknames)
+                (*nicknames)[i] = toJs(env, maybe_string(c.nickname));
+            if (approved)
+                set_bit(approved, i, c.approved);
+            if (approved_me)
+                set_bit(approved_me, i, c.approved_me);
+            if (blocked)
+                set_bit(blocked, i, c.blocked);
+            if (priority)
+                priority[i] = c.priority;
+            if (created)
+                created[i] = c.created;
+            if (profile_updated)
+                profile_updated[i] = c.profile_updated.time_since_epoch().count();
+            if (exp_mode)
+                exp_mode[i] = expiration_mode_code(c.exp_mode);
+            if (exp_timer)
+                exp_timer[i] = c.exp_timer.count();
+            if (pro_bitset)
+                pro_bitset[i] = c.profile_bitset.data;
+        }
+        return result;
+    });
+}
+
 /** ==============================
  *             SETTERS
  * ============================== */
@@ -113,7 +315,7 @@ void ContactsConfigWrapper::set(const Napi::CallbackInfo& info) {
         if (obj.IsEmpty())
             throw std::invalid_argument("cppContact received empty");
 
-        auto contact = config.get_or_construct(toCppString(obj.Get("id"), "contacts.set, id"));
+        auto contact = config().get_or_construct(toCppString(obj.Get("id"), "contacts.set, id"));
 
         auto createdFromJS =
                 toCppInteger(obj.Get("createdAtSeconds"), "contacts.set, createdAtSeconds", false);
@@ -167,7 +369,8 @@ void ContactsConfigWrapper::set(const Napi::CallbackInfo& info) {
             contact.profile_bitset.data = *proProfileBitset;
         }
 
-        config.set(contact);
+        mutated();
+        config().set(contact);
     });
 }
 
@@ -176,7 +379,10 @@ void ContactsConfigWrapper::set(const Napi::CallbackInfo& info) {
  * ============================== */
 
 Napi::Value ContactsConfigWrapper::erase(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return config.erase(getStringArgs<1>(info)); });
+    return wrapResult(info, [&] {
+        mutated();
+        return config().erase(getStringArgs<1>(info));
+    });
 }
 
 }  // namespace session::nodeapi
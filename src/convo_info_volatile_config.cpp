@@ -6,6 +6,7 @@
 
 #include "base_config.hpp"
 #include "community.hpp"
+#include "cursor.hpp"
 #include "session/config/convo_info_volatile.hpp"
 #include "utilities.hpp"
 
@@ -22,11 +23,6 @@ struct ParsedBaseValues {
     Napi::Object obj;
 };
 
-void addBaseValues(const Napi::Env& env, Napi::Object obj, const convo::base& base) {
-    obj["lastReadTsMs"] = toJs(env, base.last_read);
-    obj["forcedUnread"] = toJs(env, base.unread);
-}
-
 ParsedBaseValues parseBaseValues(
         const Napi::CallbackInfo& info, convo::base& base, const std::string fnName) {
     assertInfoLength(info, 2);
@@ -49,70 +45,131 @@ ParsedBaseValues parseBaseValues(
     return result;
 }
 
+// Whether a 1o1 convo has (valid) pro details, converted to null otherwise.
+static bool has_pro(const convo::one_to_one& c) {
+    return !c.pro_revocation_tag->empty() && c.pro_expiry_at.time_since_epoch().count();
+}
+
+static constexpr auto one_to_one_fields = field_table<convo::one_to_one>({
+        {"pubkeyHex", [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.session_id); }},
+        {"lastReadTsMs", [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.last_read); }},
+        {"forcedUnread", [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.unread); }},
+        {"proRevocationTagB64",
+         [](auto& env, auto& c) -> Napi::Value {
+             if (!has_pro(c))
+                 return env.Null();
+             return toJs(env, to_base64(*c.pro_revocation_tag));
+         }},
+        {"proExpiryTsMs",
+         [](auto& env, auto& c) -> Napi::Value {
+             if (!has_pro(c))
+                 return env.Null();
+             // config field is now whole seconds; the JS `proExpiryTsMs` key stays milliseconds
+             return toJs(env, c.pro_expiry_at.time_since_epoch().count() * 1000);
+         }},
+});
+
+template <>
+struct entity_fields<convo::one_to_one> {
+    static constexpr const auto& fields = one_to_one_fields;
+};
+
 template <>
 struct toJs_impl<convo::one_to_one> {
     Napi::Object operator()(const Napi::Env& env, const convo::one_to_one& info_1o1) {
+        return one_to_one_fields.to_js(env, info_1o1);
+    }
+};
 
-        auto obj = Napi::Object::New(env);
-
-        obj["pubkeyHex"] = toJs(env, info_1o1.session_id);
-        addBaseValues(env, obj, info_1o1);
-
-        if (info_1o1.pro_revocation_tag->empty() ||
-            !info_1o1.pro_expiry_at.time_since_epoch().count()) {
-            obj["proRevocationTagB64"] = env.Null();
-            obj["proExpiryTsMs"] = env.Null();
-        } else {
-            obj["proRevocationTagB64"] = toJs(env, to_base64(*info_1o1.pro_revocation_tag));
-            // config field is now whole seconds; the JS `proExpiryTsMs` key stays milliseconds
-            obj["proExpiryTsMs"] =
-                    toJs(env, info_1o1.pro_expiry_at.time_since_epoch().count() * 1000);
-        }
+static constexpr auto legacy_group_fields = field_table<convo::legacy_group>({
+        {"pubkeyHex", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.id); }},
+        {"lastReadTsMs", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.last_read); }},
+        {"forcedUnread", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.unread); }},
+});
 
-        return obj;
-    }
+template <>
+struct entity_fields<convo::legacy_group> {
+    static constexpr const auto& fields = legacy_group_fields;
 };
 
 template <>
 struct toJs_impl<convo::legacy_group> {
-    Napi::Object operator()(const Napi::Env& env, const convo::legacy_group info_legacy) {
-        auto obj = Napi::Object::New(env);
-
-        obj["pubkeyHex"] = toJs(env, info_legacy.id);
-        addBaseValues(env, obj, info_legacy);
-
-        return obj;
+    Napi::Object operator()(const Napi::Env& env, const convo::legacy_group& info_legacy) {
+        return legacy_group_fields.to_js(env, info_legacy);
     }
 };
 
+static constexpr auto community_fields = field_table<convo::community>({
+        {"fullUrlWithPubkey",
+         [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.full_url()); }},
+        {"baseUrl", [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.base_url()); }},
+        {"roomCasePreserved",
+         [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.room()); }},
+        {"pubkeyHex", [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.pubkey_hex()); }},
+        {"lastReadTsMs", [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.last_read); }},
+        {"forcedUnread", [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.unread); }},
+});
+
 template <>
-struct toJs_impl<convo::community> : toJs_impl<config::community> {
-    Napi::Object operator()(const Napi::Env& env, const convo::community info_comm) {
-        auto obj = toJs_impl<config::community>::operator()(env, info_comm);
-        addBaseValues(env, obj, info_comm);
+struct entity_fields<convo::community> {
+    static constexpr const auto& fields = community_fields;
+};
 
-        return obj;
+template <>
+struct toJs_impl<convo::community> {
+    Napi::Object operator()(const Napi::Env& env, const convo::community& info_comm) {
+        return community_fields.to_js(env, info_comm);
     }
 };
 
-template <>
-struct toJs_impl<convo::group> {
-    Napi::Object operator()(const Napi::Env& env, const convo::group group_info) {
-        auto obj = Napi::Object::New(env);
+static constexpr auto group_fields = field_table<convo::group>({
+        {"pubkeyHex", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.id); }},
+        {"lastReadTsMs", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.last_read); }},
+        {"forcedUnread", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.unread); }},
+});
 
-        obj["pubkeyHex"] = toJs(env, group_info.id);
-        addBaseValues(env, obj, group_info);
+template <>
+struct entity_fields<convo::group> {
+    static constexpr const auto& fields = group_fields;
+};
 
-        return obj;
+template <>
+struct toJs_impl<convo::group> {
+    Napi::Object operator()(const Napi::Env& env, const convo::group& group_info) {
+        return group_fields.to_js(env, group_info);
     }
 };
 
+// The keys and fingerprints of the convos, for the change sets of merge().
+static std::pair<std::string, uint64_t> one_to_one_fingerprint(const convo::one_to_one& c) {
+    Fingerprint fp;
+    fp.add(c.last_read, c.unread, has_pro(c));
+    if (has_pro(c))
+        fp.add(*c.pro_revocation_tag, c.pro_expiry_at);
+    return {c.session_id, fp.value()};
+}
+
+static std::pair<std::string, uint64_t> legacy_group_fingerprint(const convo::legacy_group& g) {
+    return {g.id, Fingerprint{}.add(g.last_read, g.unread).value()};
+}
+
+static std::pair<std::string, uint64_t> group_fingerprint(const convo::group& g) {
+    return {g.id, Fingerprint{}.add(g.last_read, g.unread).value()};
+}
+
+static std::pair<std::string, uint64_t> community_fingerprint(const convo::community& c) {
+    return {c.full_url(), Fingerprint{}.add(c.last_read, c.unread).value()};
+}
+
 void ConvoInfoVolatileWrapper::Init(Napi::Env env, Napi::Object exports) {
     InitHelper<ConvoInfoVolatileWrapper>(
             env,
             exports,
             "ConvoInfoVolatileWrapperNode",
             {
+                    StaticMethod<&createAsync<ConvoInfoVolatileWrapper, ConvoInfoVolatile>>(
+                            "createAsync"),
+
                     // 1o1 related methods
                     InstanceMethod("get1o1", &ConvoInfoVolatileWrapper::get1o1),
                     InstanceMethod("getAll1o1", &ConvoInfoVolatileWrapper::getAll1o1),
@@ -142,11 +199,28 @@ void ConvoInfoVolatileWrapper::Init(Napi::Env env, Napi::Object exports) {
                     InstanceMethod(
                             "eraseCommunityByFullUrl",
                             &ConvoInfoVolatileWrapper::eraseCommunityByFullUrl),
+
+                    // batched iteration over any of the above
+                    InstanceMethod("iterate", &ConvoInfoVolatileWrapper::iterate),
             });
 }
 
+// The collection fingerprints of a ConvoInfoVolatile config (see config_fingerprinter).
+static config_fingerprints convo_fingerprints(config::ConfigBase& base) {
+    auto& conf = static_cast<ConvoInfoVolatile&>(base);
+    return {
+            {"1o1", fingerprint_all(conf.begin_1to1(), conf.end(), one_to_one_fingerprint)},
+            {"legacyGroup",
+             fingerprint_all(conf.begin_legacy_groups(), conf.end(), legacy_group_fingerprint)},
+            {"group", fingerprint_all(conf.begin_groups(), conf.end(), group_fingerprint)},
+            {"community",
+             fingerprint_all(conf.begin_communities(), conf.end(), community_fingerprint)},
+    };
+}
+
 ConvoInfoVolatileWrapper::ConvoInfoVolatileWrapper(const Napi::CallbackInfo& info) :
-        ConfigBaseImpl{construct<ConvoInfoVolatile>(info, "ConvoInfoVolatile")},
+        ConfigBaseImpl{
+                construct<ConvoInfoVolatile>(info, CLASS_NAME), CLASS_NAME, convo_fingerprints},
         Napi::ObjectWrap<ConvoInfoVolatileWrapper>{info} {}
 
 /**
@@ -156,11 +230,14 @@ ConvoInfoVolatileWrapper::ConvoInfoVolatileWrapper(const Napi::CallbackInfo& inf
  */
 
 Napi::Value ConvoInfoVolatileWrapper::get1o1(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return config.get_1to1(getStringArgs<1>(info)); });
+    return wrapResult(info, [&] { return config().get_1to1(getStringArgs<1>(info)); });
 }
 
 Napi::Value ConvoInfoVolatileWrapper::getAll1o1(const Napi::CallbackInfo& info) {
-    return get_all_impl(info, config.size_1to1(), config.begin_1to1(), config.end());
+    return wrapResult(info, [&] {
+        auto& conf = config();
+        return get_all_impl(info, conf.size_1to1(), conf.begin_1to1(), conf.end());
+    });
 }
 
 void ConvoInfoVolatileWrapper::set1o1(const Napi::CallbackInfo& info) {
@@ -170,7 +247,7 @@ void ConvoInfoVolatileWrapper::set1o1(const Napi::CallbackInfo& info) {
         assertIsString(first);
 
         std::string fnName = "ConvoInfoVolatileWrapper::set1o1.";
-        auto convo = config.get_or_construct_1to1(toCppString(first, fnName + "convoInfo"));
+        auto convo = config().get_or_construct_1to1(toCppString(first, fnName + "convoInfo"));
 
         auto parsed = parseBaseValues(info, convo, fnName);
         if (parsed.lastReadTsMs > convo.last_read)
@@ -207,12 +284,16 @@ void ConvoInfoVolatileWrapper::set1o1(const Napi::CallbackInfo& info) {
                             std::chrono::milliseconds(*proExpiryUnixTsMsCpp)));
         }
 
-        config.set(convo);
+        mutated();
+        config().set(convo);
     });
 }
 
 Napi::Value ConvoInfoVolatileWrapper::erase1o1(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return config.erase_1to1(getStringArgs<1>(info)); });
+    return wrapResult(info, [&] {
+        mutated();
+        return config().erase_1to1(getStringArgs<1>(info));
+    });
 }
 
 /**
@@ -222,12 +303,15 @@ Napi::Value ConvoInfoVolatileWrapper::erase1o1(const Napi::CallbackInfo& info) {
  */
 
 Napi::Value ConvoInfoVolatileWrapper::getLegacyGroup(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return config.get_legacy_group(getStringArgs<1>(info)); });
+    return wrapResult(info, [&] { return config().get_legacy_group(getStringArgs<1>(info)); });
 }
 
 Napi::Value ConvoInfoVolatileWrapper::getAllLegacyGroups(const Napi::CallbackInfo& info) {
-    return get_all_impl(
-            info, config.size_legacy_groups(), config.begin_legacy_groups(), config.end());
+    return wrapResult(info, [&] {
+        auto& conf = config();
+        return get_all_impl(
+                info, conf.size_legacy_groups(), conf.begin_legacy_groups(), conf.end());
+    });
 }
 
 void ConvoInfoVolatileWrapper::setLegacyGroup(const Napi::CallbackInfo& info) {
@@ -237,19 +321,24 @@ void ConvoInfoVolatileWrapper::setLegacyGroup(const Napi::CallbackInfo& info) {
         assertIsString(first);
 
         std::string fnName = "ConvoInfoVolatileWrapper::setLegacyGroup.";
-        auto convo = config.get_or_construct_legacy_group(toCppString(first, fnName + "convoInfo"));
+        auto convo = config().get_or_construct_legacy_group(
+                toCppString(first, fnName + "convoInfo"));
 
         auto parsed = parseBaseValues(info, convo, fnName);
         if (parsed.lastReadTsMs > convo.last_read)
             convo.last_read = parsed.lastReadTsMs;
         convo.unread = parsed.forcedUnread;
 
-        config.set(convo);
+        mutated();
+        config().set(convo);
     });
 }
 
 Napi::Value ConvoInfoVolatileWrapper::eraseLegacyGroup(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return config.erase_legacy_group(getStringArgs<1>(info)); });
+    return wrapResult(info, [&] {
+        mutated();
+        return config().erase_legacy_group(getStringArgs<1>(info));
+    });
 }
 
 /**
@@ -259,11 +348,14 @@ Napi::Value ConvoInfoVolatileWrapper::eraseLegacyGroup(const Napi::CallbackInfo&
  */
 
 Napi::Value ConvoInfoVolatileWrapper::getGroup(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return config.get_group(getStringArgs<1>(info)); });
+    return wrapResult(info, [&] { return config().get_group(getStringArgs<1>(info)); });
 }
 
 Napi::Value ConvoInfoVolatileWrapper::getAllGroups(const Napi::CallbackInfo& info) {
-    return get_all_impl(info, config.size_groups(), config.begin_groups(), config.end());
+    return wrapResult(info, [&] {
+        auto& conf = config();
+        return get_all_impl(info, conf.size_groups(), conf.begin_groups(), conf.end());
+    });
 }
 
 void ConvoInfoVolatileWrapper::setGroup(const Napi::CallbackInfo& info) {
@@ -273,19 +365,23 @@ void ConvoInfoVolatileWrapper::setGroup(const Napi::CallbackInfo& info) {
         assertIsString(first);
 
         std::string fnName = "ConvoInfoVolatileWrapper::setGroup.";
-        auto convo = config.get_or_construct_group(toCppString(first, fnName + "convoInfo"));
+        auto convo = config().get_or_construct_group(toCppString(first, fnName + "convoInfo"));
 
         auto parsed = parseBaseValues(info, convo, fnName);
         if (parsed.lastReadTsMs > convo.last_read)
             convo.last_read = parsed.lastReadTsMs;
         convo.unread = parsed.forcedUnread;
 
-        config.set(convo);
+        mutated();
+        config().set(convo);
     });
 }
 
 Napi::Value ConvoInfoVolatileWrapper::eraseGroup(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return config.erase_group(getStringArgs<1>(info)); });
+    return wrapResult(info, [&] {
+        mutated();
+        return config().erase_group(getStringArgs<1>(info));
+    });
 }
 
 /**
@@ -295,11 +391,14 @@ Napi::Value ConvoInfoVolatileWrapper::eraseGroup(const Napi::CallbackInfo& info)
  */
 
 Napi::Value ConvoInfoVolatileWrapper::getCommunity(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return config.get_community(getStringArgs<1>(info)); });
+    return wrapResult(info, [&] { return config().get_community(getStringArgs<1>(info)); });
 }
 
 Napi::Value ConvoInfoVolatileWrapper::getAllCommunities(const Napi::CallbackInfo& info) {
-    return get_all_impl(info, config.size_communities(), config.begin_communities(), config.end());
+    return wrapResult(info, [&] {
+        auto& conf = config();
+        return get_all_impl(info, conf.size_communities(), conf.begin_communities(), conf.end());
+    });
 }
 
 // TODO maybe make the setXXX   return the update value so we avoid having to
@@ -313,7 +412,7 @@ void ConvoInfoVolatileWrapper::setCommunityByFullUrl(const Napi::CallbackInfo& i
 
         std::string fnName = "ConvoInfoVolatileWrapper::setCommunityByFullUrl.";
 
-        auto convo = config.get_or_construct_community(toCppString(first, fnName + "convoInfo"));
+        auto convo = config().get_or_construct_community(toCppString(first, fnName + "convoInfo"));
 
         auto parsed = parseBaseValues(info, convo, fnName);
         if (parsed.lastReadTsMs > convo.last_read)
@@ -323,14 +422,43 @@ void ConvoInfoVolatileWrapper::setCommunityByFullUrl(const Napi::CallbackInfo& i
         // Note: we only keep the messages read when their timestamp is not older
         // than 30 days or so (see libsession util PRUNE constant). so this `set()`
         // here might actually not create an entry
-        config.set(convo);
+        mutated();
+        config().set(convo);
     });
 }
 
 Napi::Value ConvoInfoVolatileWrapper::eraseCommunityByFullUrl(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
         auto [base, room, pubkey] = config::community::parse_full_url(getStringArgs<1>(info));
-        return config.erase_community(base, room);
+        mutated();
+        return config().erase_community(base, room);
+    });
+}
+
+/**
+ * =================================================
+ * ==================== CURSORS ====================
+ * =================================================
+ */
+
+Napi::Value ConvoInfoVolatileWrapper::iterate(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        checkOrThrow(info.Length() <= 1, "Invalid number of arguments");
+        auto opts = cursor_options_from_JS(info[0]);
+        auto& conf = config();
+        auto type = opts.type.value_or("");
+        if (type == "1o1")
+            return make_entity_cursor(info, cursor_guard(), opts, conf.begin_1to1(), conf.end());
+        if (type == "legacyGroup")
+            return make_entity_cursor(
+                    info, cursor_guard(), opts, conf.begin_legacy_groups(), conf.end());
+        if (type == "group")
+            return make_entity_cursor(info, cursor_guard(), opts, conf.begin_groups(), conf.end());
+        if (type == "community")
+            return make_entity_cursor(
+                    info, cursor_guard(), opts, conf.begin_communities(), conf.end());
+        throw std::invalid_argument{
+                "iterate: type must be one of 1o1, legacyGroup, group, community"};
     });
 }
 
@@ -0,0 +1,104 @@
+#include "cursor.hpp"
+
+#include <napi.h>
+
+#include "addon_data.hpp"
+#include "base_config.hpp"
+
+namespace session::nodeapi {
+
+static constexpr const char* CURSOR_CLASS_NAME = "ConfigCursorNode";
+
+// Passed from make() to the constructor, see construct_adopting().
+struct cursor_init {
+    Napi::Object owner;
+    std::function<void()> guard;
+    std::unique_ptr<CursorSource> source;
+    size_t batch_size;
+};
+
+cursor_options cursor_options_from_JS(const Napi::Value& val) {
+    cursor_options opts;
+    if (val.IsUndefined() || val.IsNull())
+        return opts;
+
+    assertIsObject(val);
+    auto obj = val.As<Napi::Object>();
+    if (auto batch_size = maybeNonemptyInt(obj.Get("batchSize"), "iterate batchSize")) {
+        if (*batch_size <= 0)
+            throw std::invalid_argument{"iterate batchSize must be a positive number"};
+        opts.batch_size = static_cast<size_t>(*batch_size);
+    }
+    opts.type = maybeNonemptyString(obj.Get("type"), "iterate type");
+    opts.fields = obj.Get("fields");
+    return opts;
+}
+
+void ConfigCursor::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function cls = DefineClass(
+            env,
+            CURSOR_CLASS_NAME,
+            {
+                    InstanceMethod("next", &ConfigCursor::next),
+                    InstanceMethod("close", &ConfigCursor::close),
+            });
+
+    AddonData::get(env).add_constructor(CURSOR_CLASS_NAME, cls);
+
+    exports.Set(CURSOR_CLASS_NAME, cls);
+}
+
+ConfigCursor::ConfigCursor(const Napi::CallbackInfo& info) : Napi::ObjectWrap<ConfigCursor>{info} {
+    wrapExceptions(info, [&] {
+        auto* init = adopted<cursor_init>(info);
+        if (!init)
+            throw std::invalid_argument{
+                    "ConfigCursorNode cannot be constructed directly: use the wrappers' iterate()"};
+
+        owner_ = Napi::Persistent(init->owner);
+        guard_ = std::move(init->guard);
+        source_ = std::move(init->source);
+        batch_size_ = init->batch_size;
+    });
+}
+
+Napi::Object ConfigCursor::make(
+        Napi::Env env,
+        Napi::Object owner,
+        std::function<void()> guard,
+        std::unique_ptr<CursorSource> source,
+        size_t batch_size) {
+    return construct_adopting(
+            AddonData::get(env).constructor(CURSOR_CLASS_NAME),
+            cursor_init{owner, std::move(guard), std::move(source), batch_size});
+}
+
+void ConfigCursor::release() {
+    source_.reset();
+    guard_ = nullptr;
+    owner_.Reset();
+}
+
+Napi::Value ConfigCursor::next(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 0);
+        auto env = info.Env();
+        if (!source_)
+            return Napi::Array::New(env);
+
+        guard_();
+        auto batch = source_->next(env, batch_size_);
+        if (batch.Length() < batch_size_)
+            release();
+        return batch;
+    });
+}
+
+void ConfigCursor::close(const Napi::CallbackInfo& info) {
+    wrapExceptions(info, [&] {
+        assertInfoLength(info, 0);
+        release();
+    });
+}
+
+}  // namespace session::nodeapi
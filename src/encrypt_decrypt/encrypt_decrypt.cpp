@@ -7,6 +7,8 @@
 #include <algorithm>
 #include <vector>
 
+#include "async_worker.hpp"
+#include "parallel.hpp"
 #include "pro/types.hpp"
 #include "session/attachments.hpp"
 #include "session/multi_encrypt.hpp"
@@ -388,48 +390,169 @@ Napi::Value MultiEncryptWrapper::attachmentDecrypt(const Napi::CallbackInfo& inf
  * ===========================================
  */
 
-Napi::Value MultiEncryptWrapper::encryptFor1o1(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] {
-        // we expect a single argument which is an array of objects with the following
-        // properties:
-        // {
-        //   "plaintext": Uint8Array,
-        //   "sentTimestampMs": Number,
-        //   "senderEd25519Seed": Hexstring,
-        //   "recipientPubkey": Hexstring,
-        //   "proRotatingEd25519PrivKey": Hexstring | null,
-        // }
-        //
+// The extracted arguments of a single encryptFor1o1 item.
+struct encode_1o1_item {
+    std::vector<unsigned char> plaintext;
+    std::vector<unsigned char> sender_ed25519_seed;
+    std::chrono::milliseconds sent_timestamp;
+    session::array_uc33 recipient_pubkey;
+    std::optional<std::vector<unsigned char>> pro_rotating_ed25519_privkey;
+
+    // {
+    //   "plaintext": Uint8Array,
+    //   "sentTimestampMs": Number,
+    //   "senderEd25519Seed": Hexstring,
+    //   "recipientPubkey": Hexstring,
+    //   "proRotatingEd25519PrivKey": Hexstring | null,
+    // }
+    static encode_1o1_item from_JS(const Napi::Object& obj, const std::string& name) {
+        return {.plaintext = extractPlaintext(obj, name + ".obj.plaintext"),
+                .sender_ed25519_seed =
+                        extractSenderEd25519SeedAsVector(obj, name + ".obj.senderEd25519Seed"),
+                .sent_timestamp = extractSentTimestampMs(obj, name + ".obj.sentTimestampMs"),
+                .recipient_pubkey =
+                        extractRecipientPubkeyAsArray(obj, name + ".obj.recipientPubkey"),
+                .pro_rotating_ed25519_privkey = extractProRotatingEd25519PrivKeyAsVector(
+                        obj, name + ".obj.proRotatingEd25519PrivKey")};
+    }
 
-        assertInfoLength(info, 1);
-        assertIsArray(info[0], "encryptFor1o1 info[0]");
+    std::vector<unsigned char> encode() const {
+        return session::encode_for_1o1(
+                plaintext,
+                sender_ed25519_seed,
+                sent_timestamp,
+                recipient_pubkey,
+                pro_rotating_ed25519_privkey);
+    }
+};
 
-        auto array = info[0].As<Napi::Array>();
+// The extracted arguments of a single encryptForCommunity item.
+struct encode_community_item {
+    std::vector<unsigned char> plaintext;
+    std::optional<std::vector<unsigned char>> pro_rotating_ed25519_privkey;
+
+    // {
+    //   "plaintext": Uint8Array,
+    //   "proRotatingEd25519PrivKey": Hexstring | null,
+    // }
+    static encode_community_item from_JS(const Napi::Object& obj, const std::string& name) {
+        return {.plaintext = extractPlaintext(obj, name + ".obj.plaintext"),
+                .pro_rotating_ed25519_privkey = extractProRotatingEd25519PrivKeyAsVector(
+                        obj, name + ".obj.proRotatingEd25519PrivKey")};
+    }
 
-        if (array.IsEmpty())
-            throw std::invalid_argument("encryptFor1o1 received empty");
+    std::vector<unsigned char> encode() const {
+        return session::encode_for_community(plaintext, pro_rotating_ed25519_privkey);
+    }
+};
 
-        std::vector<std::vector<uint8_t>> ready_to_send(array.Length());
-        for (uint32_t i = 0; i < array.Length(); i++) {
-            auto itemValue = array.Get(i);
-            if (!itemValue.IsObject()) {
-                throw std::invalid_argument("encryptFor1o1 itemValue is not an object");
-            }
-            auto obj = itemValue.As<Napi::Object>();
+// The extracted arguments of a single encryptForGroup item.
+struct encode_group_item {
+    std::vector<unsigned char> plaintext;
+    std::vector<unsigned char> sender_ed25519_seed;
+    std::chrono::milliseconds sent_timestamp;
+    session::array_uc33 group_ed25519_pubkey;
+    cleared_uc32 group_enc_key;
+    std::optional<std::vector<unsigned char>> pro_rotating_ed25519_privkey;
+
+    // {
+    //   "plaintext": Uint8Array,
+    //   "senderEd25519Seed": Uint8Array, 32 bytes
+    //   "sentTimestampMs": Number,
+    //   "groupEd25519Pubkey": Hexstring,
+    //   "groupEncKey": Hexstring,
+    //   "proRotatingEd25519PrivKey": Hexstring | null,
+    // }
+    static encode_group_item from_JS(const Napi::Object& obj, const std::string& name) {
+        return {.plaintext = extractPlaintext(obj, name + ".obj.plaintext"),
+                .sender_ed25519_seed =
+                        extractSenderEd25519SeedAsVector(obj, name + ".obj.senderEd25519Seed"),
+                .sent_timestamp = extractSentTimestampMs(obj, name + ".obj.sentTimestampMs"),
+                .group_ed25519_pubkey =
+                        extractGroupEd25519PubkeyAsArray(obj, name + ".obj.recipientPubkey"),
+                .group_enc_key = extractGroupEncKeyAsArray(obj, name + ".obj.groupEncKey"),
+                .pro_rotating_ed25519_privkey = extractProRotatingEd25519PrivKeyAsVector(
+                        obj, name + ".obj.proRotatingEd25519PrivKey")};
+    }
 
-            ready_to_send[i] = session::encode_for_1o1(
-                    extractPlaintext(obj, "encryptFor1o1.obj.plaintext"),
-                    extractSenderEd25519SeedAsVector(obj, "encryptFor1o1.obj.senderEd25519Seed"),
-                    extractSentTimestampMs(obj, "encryptFor1o1.obj.sentTimestampMs"),
-                    extractRecipientPubkeyAsArray(obj, "encryptFor1o1.obj.recipientPubkey"),
-                    extractProRotatingEd25519PrivKeyAsVector(
-                            obj, "encryptFor1o1.obj.proRotatingEd25519PrivKey"));
+    std::vector<unsigned char> encode() const {
+        return session::encode_for_group(
+                plaintext,
+                sender_ed25519_seed,
+                sent_timestamp,
+                group_ed25519_pubkey,
+                group_enc_key,
+                pro_rotating_ed25519_privkey);
+    }
+};
+
+// Extracts the single "array of items" argument all the encryptFor* calls take.
+template <typename Item>
+static std::vector<Item> encode_items_from_JS(
+        const Napi::CallbackInfo& info, const std::string& name) {
+    assertInfoLength(info, 1);
+    assertIsArray(info[0], name + " info[0]");
+
+    auto array = info[0].As<Napi::Array>();
+
+    if (array.IsEmpty())
+        throw std::invalid_argument(name + " received empty");
+
+    std::vector<Item> items;
+    items.reserve(array.Length());
+    for (uint32_t i = 0; i < array.Length(); i++) {
+        auto itemValue = array.Get(i);
+        if (!itemValue.IsObject()) {
+            throw std::invalid_argument(name + " itemValue is not an object");
         }
+        items.push_back(Item::from_JS(itemValue.As<Napi::Object>(), name));
+    }
+    return items;
+}
 
-        auto ret = Napi::Object::New(info.Env());
-        ret.Set("encryptedData", toJs(info.Env(), ready_to_send));
+// Encodes each of `items`, in parallel if `parallel` is set, returning the encoded messages in
+// input order.  Any failure aborts the whole batch.
+template <typename Item>
+static std::vector<std::vector<unsigned char>> encode_items(
+        const std::vector<Item>& items, bool parallel) {
+    std::vector<std::vector<unsigned char>> ready_to_send(items.size());
+    auto encode_one = [&](size_t i) { ready_to_send[i] = items[i].encode(); };
+
+    if (parallel)
+        parallel_for(items.size(), encode_one);
+    else
+        for (size_t i = 0; i < items.size(); i++)
+            encode_one(i);
+
+    return ready_to_send;
+}
 
-        return ret;
+static Napi::Object encrypted_data_to_JS(
+        const Napi::Env& env, std::vector<std::vector<unsigned char>>&& ready_to_send) {
+    auto ret = Napi::Object::New(env);
+    ret.Set("encryptedData", toJs(env, std::move(ready_to_send)));
+
+    return ret;
+}
+
+// Queues the encoding of `items` on the threadpool, fanned out with parallel_for, returning a
+// promise of the same `{encryptedData}` object the synchronous call returns.
+template <typename Item>
+static Napi::Promise encode_items_async(const Napi::Env& env, std::vector<Item> items) {
+    auto* worker = makePromiseWorker(
+            env,
+            "MultiEncryptWrapper::encodeItems",
+            [items = std::move(items)] { return encode_items(items, true); },
+            [](const Napi::Env& env, std::vector<std::vector<unsigned char>>&& encoded) {
+                return encrypted_data_to_JS(env, std::move(encoded));
+            });
+    return worker->QueuePromise();
+}
+
+Napi::Value MultiEncryptWrapper::encryptFor1o1(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        auto items = encode_items_from_JS<encode_1o1_item>(info, "encryptFor1o1");
+        return encrypted_data_to_JS(info.Env(), encode_items(items, false));
     });
 };
 
@@ -478,7 +601,7 @@ Napi::Value MultiEncryptWrapper::encryptForCommunityInbox(const Napi::CallbackIn
         }
 
         auto ret = Napi::Object::New(info.Env());
-        ret.Set("encryptedData", toJs(info.Env(), ready_to_send));
+        ret.Set("encryptedData", toJs(info.Env(), std::move(ready_to_send)));
 
         return ret;
     });
@@ -486,100 +609,37 @@ Napi::Value MultiEncryptWrapper::encryptForCommunityInbox(const Napi::CallbackIn
 
 Napi::Value MultiEncryptWrapper::encryptForCommunity(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
-        // we expect a single argument which is an array of objects with the following
-        // properties:
-        // {
-        //   "plaintext": Uint8Array,
-        //   "proRotatingEd25519PrivKey": Hexstring | null,
-        // }
-        //
-
-        assertInfoLength(info, 1);
-        assertIsArray(info[0], "encryptForCommunity info[0]");
-
-        auto array = info[0].As<Napi::Array>();
-
-        if (array.IsEmpty())
-            throw std::invalid_argument("encryptForCommunity received empty");
-
-        std::vector<std::vector<uint8_t>> ready_to_send(array.Length());
-        for (uint32_t i = 0; i < array.Length(); i++) {
-            auto itemValue = array.Get(i);
-            if (!itemValue.IsObject()) {
-                throw std::invalid_argument("encryptForCommunity itemValue is not an object");
-            }
-            auto obj = itemValue.As<Napi::Object>();
-
-            ready_to_send[i] = session::encode_for_community(
-                    extractPlaintext(obj, "encryptForCommunity.obj.plaintext"),
-                    extractProRotatingEd25519PrivKeyAsVector(
-                            obj, "encryptForCommunity.obj.proRotatingEd25519PrivKey"));
-        }
-
-        auto ret = Napi::Object::New(info.Env());
-        ret.Set("encryptedData", toJs(info.Env(), ready_to_send));
-
-        return ret;
+        auto items = encode_items_from_JS<encode_community_item>(info, "encryptForCommunity");
+        return encrypted_data_to_JS(info.Env(), encode_items(items, false));
     });
 };
 
 Napi::Value MultiEncryptWrapper::encryptForGroup(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
-        // we expect a single argument which is an array of objects with the following
-        // properties:
-        // {
-        //   "plaintext": Uint8Array,
-        //   "senderEd25519Seed": Uint8Array, 32 bytes
-        //   "sentTimestampMs": Number,
-        //   "groupEd25519Pubkey": Hexstring,
-        //   "groupEncKey": Hexstring,
-        //   "proRotatingEd25519PrivKey": Hexstring | null,
-        // }
-        //
-
-        assertInfoLength(info, 1);
-        assertIsArray(info[0], "encryptForGroup info[0]");
-
-        auto array = info[0].As<Napi::Array>();
-
-        if (array.IsEmpty())
-            throw std::invalid_argument("encryptForGroup received empty");
-
-        std::vector<std::vector<uint8_t>> ready_to_send(array.Length());
-        for (uint32_t i = 0; i < array.Length(); i++) {
-            auto itemValue = array.Get(i);
-            if (!itemValue.IsObject()) {
-                throw std::invalid_argument("encryptForGroup itemValue is not an object");
-            }
-            auto obj = itemValue.As<Napi::Object>();
-
-            auto plaintext = extractPlaintext(obj, "encryptForGroup.obj.plaintext");
-            auto senderEd25519Seed =
-                    extractSenderEd25519SeedAsVector(obj, "encryptForGroup.obj.senderEd25519Seed");
-
-            auto sentTimestampMs =
-                    extractSentTimestampMs(obj, "encryptForGroup.obj.sentTimestampMs");
-
-            auto groupEd25519Pubkey =
-                    extractGroupEd25519PubkeyAsArray(obj, "encryptForGroup.obj.recipientPubkey");
-
-            auto groupEncKey = extractGroupEncKeyAsArray(obj, "encryptForGroup.obj.groupEncKey");
-            auto proRotatingEd25519PrivKey = extractProRotatingEd25519PrivKeyAsVector(
-                    obj, "encryptForGroup.obj.proRotatingEd25519PrivKey");
+        auto items = encode_items_from_JS<encode_group_item>(info, "encryptForGroup");
+        return encrypted_data_to_JS(info.Env(), encode_items(items, false));
+    });
+};
 
-            ready_to_send[i] = session::encode_for_group(
-                    plaintext,
-                    senderEd25519Seed,
-                    sentTimestampMs,
-                    groupEd25519Pubkey,
-                    groupEncKey,
-                    proRotatingEd25519PrivKey);
-        }
+Napi::Value MultiEncryptWrapper::encryptFor1o1Async(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        return encode_items_async(
+                info.Env(), encode_items_from_JS<encode_1o1_item>(info, "encryptFor1o1Async"));
+    });
+};
 
-        auto ret = Napi::Object::New(info.Env());
-        ret.Set("encryptedData", toJs(info.Env(), ready_to_send));
+Napi::Value MultiEncryptWrapper::encryptForCommunityAsync(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        return encode_items_async(
+                info.Env(),
+                encode_items_from_JS<encode_community_item>(info, "encryptForCommunityAsync"));
+    });
+};
 
-        return ret;
+Napi::Value MultiEncryptWrapper::encryptForGroupAsync(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        return encode_items_async(
+                info.Env(), encode_items_from_JS<encode_group_item>(info, "encryptForGroupAsync"));
     });
 };
 
@@ -674,190 +734,218 @@ Napi::Value MultiEncryptWrapper::decryptForCommunity(const Napi::CallbackInfo& i
     });
 };
 
-Napi::Value MultiEncryptWrapper::decryptFor1o1(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] {
-        // we expect two arguments that match:
-        // first: [{
-        //   "envelopePayload": Uint8Array,
-        //   "messageHash": string,
-        // }],
-        // second: {
-        //   "proBackendPubkeyHex": Hexstring,
-        //   "ed25519PrivateKeyHex": Hexstring,
-        //  }
-        //
+// Owned copies of everything needed to decode a batch of envelopes, so that the decoding itself
+// does not depend on any JS value and can run off the JS thread.
+struct envelope_batch {
+    std::string name;  // the calling function, for logging
+    std::vector<std::vector<unsigned char>> decrypt_keys;
+    // groups only: the group pubkey without its 03 prefix
+    std::optional<std::vector<unsigned char>> group_ed25519_pubkey;
+    session::array_uc32 pro_backend_pubkey;
+    // (messageHash, envelopePayload) of each item, nullopt for an item we failed to extract
+    std::vector<std::optional<std::pair<std::string, std::vector<unsigned char>>>> items;
+};
 
-        assertInfoLength(info, 2);
-        assertIsArray(info[0], "decryptFor1o1 info[0]");
-        assertIsObject(info[1]);
+using decoded_envelopes = std::vector<std::pair<DecodedEnvelope, std::string>>;
+
+static void envelope_batch_items_from_JS(envelope_batch& batch, const Napi::Array& first) {
+    batch.items.reserve(first.Length());
+
+    for (uint32_t i = 0; i < first.Length(); i++) {
+        auto itemValue = first.Get(i);
+        if (!itemValue.IsObject())
+            throw std::invalid_argument(batch.name + " itemValue is not an object");
+        auto obj = itemValue.As<Napi::Object>();
+
+        try {
+            std::string messageHash = extractMessageHash(obj, batch.name + ".obj.messageHash");
+            auto envelopePayload =
+                    extractEnvelopePayload(obj, batch.name + ".obj.envelopePayload");
+            batch.items.emplace_back(
+                    std::in_place, std::move(messageHash), std::move(envelopePayload));
+        } catch (const std::exception& e) {
+            log::warning(
+                    cat, "{}: Failed to decrypt message at index {}: {}", batch.name, i, e.what());
+            batch.items.emplace_back(std::nullopt);
+        }
+    }
+}
 
-        auto first = info[0].As<Napi::Array>();
+static envelope_batch decrypt_for_1o1_batch_from_JS(
+        const Napi::CallbackInfo& info, std::string name) {
+    // we expect two arguments that match:
+    // first: [{
+    //   "envelopePayload": Uint8Array,
+    //   "messageHash": string,
+    // }],
+    // second: {
+    //   "proBackendPubkeyHex": Hexstring,
+    //   "ed25519PrivateKeyHex": Hexstring,
+    //  }
+    //
 
-        if (first.IsEmpty())
-            throw std::invalid_argument("decryptFor1o1 first received empty");
+    assertInfoLength(info, 2);
+    assertIsArray(info[0], name + " info[0]");
+    assertIsObject(info[1]);
 
-        auto second = info[1].As<Napi::Object>();
+    auto first = info[0].As<Napi::Array>();
 
-        if (second.IsEmpty())
-            throw std::invalid_argument("decryptFor1o1 second received empty");
+    if (first.IsEmpty())
+        throw std::invalid_argument(name + " first received empty");
 
-        auto proBackendPubkeyHex =
-                extractProBackendPubkeyHex(second, "decryptFor1o1.second.proBackendPubkeyHex");
+    auto second = info[1].As<Napi::Object>();
 
-        std::vector<DecodedEnvelope> decrypted;
-        std::vector<std::string> decryptedMessageHashes;
+    if (second.IsEmpty())
+        throw std::invalid_argument(name + " second received empty");
 
-        DecodeEnvelopeKey keys{};
-        auto keySpan =
-                extractEd25519PrivateKeyHex(second, "decryptFor1o1.second.ed25519PrivateKeyHex");
+    envelope_batch batch{.name = std::move(name)};
+    batch.pro_backend_pubkey =
+            extractProBackendPubkeyHex(second, batch.name + ".second.proBackendPubkeyHex");
 
-        std::vector<std::span<const unsigned char>> keySpans;
-        keySpans.emplace_back(keySpan.data(), keySpan.size());
-        keys.decrypt_keys = keySpans;
+    auto key = extractEd25519PrivateKeyHex(second, batch.name + ".second.ed25519PrivateKeyHex");
+    batch.decrypt_keys.emplace_back(key.begin(), key.end());
 
-        for (uint32_t i = 0; i < first.Length(); i++) {
-            auto itemValue = first.Get(i);
-            if (!itemValue.IsObject()) {
-                throw std::invalid_argument(
-                        "decryptFor1o1 itemValue is not an "
-                        "object");
-            }
-            auto obj = itemValue.As<Napi::Object>();
+    envelope_batch_items_from_JS(batch, first);
+    return batch;
+}
 
-            try {
-                std::string messageHash = extractMessageHash(obj, "decryptFor1o1.obj.messageHash");
+static envelope_batch decrypt_for_group_batch_from_JS(
+        const Napi::CallbackInfo& info, std::string name) {
+    // we expect two arguments that match:
+    // first: [{
+    //   "envelopePayload": Uint8Array,
+    //   "messageHash": string,
+    // }],
+    // second: {
+    //   "proBackendPubkeyHex": Hexstring,
+    //   "ed25519GroupPubkeyHex": Hexstring,
+    //   "groupEncKeys": Array<Uint8Array>,
+    //  }
+    //
 
-                auto envelopePayload =
-                        extractEnvelopePayload(obj, "decryptFor1o1.obj.envelopePayload");
-                decrypted.push_back(
-                        session::decode_envelope(keys, envelopePayload, proBackendPubkeyHex));
-                decryptedMessageHashes.push_back(messageHash);
-            } catch (const std::exception& e) {
-                log::warning(
-                        cat,
-                        "decryptFor1o1: Failed to decrypt "
-                        "message at index {}: {}",
-                        i,
-                        e.what());
-            }
-        }
+    assertInfoLength(info, 2);
+    assertIsArray(info[0], name + " info[0]");
+    assertIsObject(info[1]);
 
-        auto ret = Napi::Array::New(info.Env(), decrypted.size());
-        uint32_t i = 0;
+    auto first = info[0].As<Napi::Array>();
 
-        for (auto& d : decrypted) {
-            auto to_insert = Napi::Object::New(info.Env());
+    if (first.IsEmpty())
+        throw std::invalid_argument(name + " first received empty");
 
-            to_insert.Set("decodedEnvelope", toJs(info.Env(), d));
-            to_insert.Set("messageHash", toJs(info.Env(), decryptedMessageHashes[i]));
+    auto second = info[1].As<Napi::Object>();
 
-            ret.Set(i, to_insert);
-            i++;
-        }
+    if (second.IsEmpty())
+        throw std::invalid_argument(name + " second received empty");
 
-        return ret;
-    });
-};
+    envelope_batch batch{.name = std::move(name)};
+    batch.pro_backend_pubkey =
+            extractProBackendPubkeyHex(second, batch.name + ".second.proBackendPubkeyHex");
 
-Napi::Value MultiEncryptWrapper::decryptForGroup(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] {
-        // we expect two arguments that match:
-        // first: [{
-        //   "envelopePayload": Uint8Array,
-        //   "messageHash": string,
-        // }],
-        // second: {
-        //   "proBackendPubkeyHex": Hexstring,
-        //   "ed25519GroupPubkeyHex": Hexstring,
-        //   "groupEncKeys": Array<Uint8Array>,
-        //  }
-        //
+    auto groupPk =
+            extractEd25519GroupPubkeyHex(second, batch.name + ".second.ed25519GroupPubkeyHex");
+    // remove prefix
+    batch.group_ed25519_pubkey.emplace(groupPk.begin() + 1, groupPk.end());
 
-        assertInfoLength(info, 2);
-        assertIsArray(info[0], "decryptForGroup info[0]");
-        assertIsObject(info[1]);
-
-        auto first = info[0].As<Napi::Array>();
-
-        if (first.IsEmpty())
-            throw std::invalid_argument("decryptForGroup first received empty");
-
-        auto second = info[1].As<Napi::Object>();
+    batch.decrypt_keys = extractGroupEncKeys(second, batch.name + ".second.groupEncKeys");
 
-        if (second.IsEmpty())
-            throw std::invalid_argument("decryptForGroup second received empty");
-
-        auto proBackendPubkeyHex =
-                extractProBackendPubkeyHex(second, "decryptForGroup.second.proBackendPubkeyHex");
-
-        std::vector<DecodedEnvelope> decrypted;
-        std::vector<std::string> decryptedMessageHashes;
-
-        DecodeEnvelopeKey keys{};
-        auto groupPk = extractEd25519GroupPubkeyHex(
-                second, "decryptForGroup.second.ed25519GroupPubkeyHex");
-
-        // this has to be vector and not spans, the memory gets freed by the function
-        std::vector<std::vector<unsigned char>> groupEncKeysVec =
-                extractGroupEncKeys(second, "decryptForGroup.second.groupEncKeys");
+    envelope_batch_items_from_JS(batch, first);
+    return batch;
+}
 
-        std::vector<std::span<const unsigned char>> span_group_enc_keys;
-        span_group_enc_keys.reserve(groupEncKeysVec.size());
-        for (const auto& inner : groupEncKeysVec) {
-            span_group_enc_keys.emplace_back(inner);
+// Decodes every item of `batch`, in parallel if `parallel` is set.  Items that fail to decode are
+// logged and skipped; the others are returned in input order.
+static decoded_envelopes decode_envelope_batch(const envelope_batch& batch, bool parallel) {
+    // DecodeEnvelopeKey only holds spans: the memory they point to is owned by `batch`.
+    std::vector<std::span<const unsigned char>> decrypt_keys(
+            batch.decrypt_keys.begin(), batch.decrypt_keys.end());
+    DecodeEnvelopeKey keys{};
+    keys.decrypt_keys = decrypt_keys;
+    if (batch.group_ed25519_pubkey)
+        keys.group_ed25519_pubkey = *batch.group_ed25519_pubkey;
+
+    std::vector<std::optional<DecodedEnvelope>> decoded(batch.items.size());
+    auto decode_one = [&](size_t i) {
+        if (!batch.items[i])
+            return;
+        try {
+            decoded[i] = session::decode_envelope(
+                    keys, batch.items[i]->second, batch.pro_backend_pubkey);
+        } catch (const std::exception& e) {
+            log::warning(
+                    cat, "{}: Failed to decrypt message at index {}: {}", batch.name, i, e.what());
         }
+    };
+
+    if (parallel)
+        parallel_for(batch.items.size(), decode_one);
+    else
+        for (size_t i = 0; i < batch.items.size(); i++)
+            decode_one(i);
+
+    decoded_envelopes result;
+    result.reserve(decoded.size());
+    for (size_t i = 0; i < decoded.size(); i++)
+        if (decoded[i])
+            result.emplace_back(std::move(*decoded[i]), batch.items[i]->first);
+    return result;
+}
 
-        // Create a span of spans
-        std::span<std::span<const unsigned char>> groupEncKeys(span_group_enc_keys);
+static Napi::Array decoded_envelopes_to_JS(
+        const Napi::Env& env, const decoded_envelopes& decrypted) {
+    auto ret = Napi::Array::New(env, decrypted.size());
+    uint32_t i = 0;
 
-        keys.decrypt_keys = groupEncKeys;
-        // remove prefix
-        std::vector<uint8_t> groupPkNoPrefix(groupPk.begin() + 1, groupPk.end());
+    for (auto& [d, messageHash] : decrypted) {
+        auto to_insert = Napi::Object::New(env);
 
-        keys.group_ed25519_pubkey = groupPkNoPrefix;
+        to_insert.Set("decodedEnvelope", toJs(env, d));
+        to_insert.Set("messageHash", toJs(env, messageHash));
 
-        for (uint32_t i = 0; i < first.Length(); i++) {
-            auto itemValue = first.Get(i);
-            if (!itemValue.IsObject()) {
-                throw std::invalid_argument(
-                        "decryptForGroup itemValue is not an "
-                        "object");
-            }
-            auto obj = itemValue.As<Napi::Object>();
+        ret.Set(i, to_insert);
+        i++;
+    }
 
-            try {
-                std::string messageHash =
-                        extractMessageHash(obj, "decryptForGroup.obj.messageHash");
-
-                auto envelopePayload =
-                        extractEnvelopePayload(obj, "decryptForGroup.obj.envelopePayload");
-                decrypted.push_back(
-                        session::decode_envelope(keys, envelopePayload, proBackendPubkeyHex));
-                decryptedMessageHashes.push_back(messageHash);
-            } catch (const std::exception& e) {
-                log::warning(
-                        cat,
-                        "decryptForGroup: Failed to decrypt "
-                        "message at index {}: {}",
-                        i,
-                        e.what());
-            }
-        }
+    return ret;
+}
 
-        auto ret = Napi::Array::New(info.Env(), decrypted.size());
-        uint32_t i = 0;
+// Queues the decoding of `batch` on the threadpool, fanned out with parallel_for, returning a
+// promise of the same array the synchronous decrypt call returns.
+static Napi::Promise decode_envelope_batch_async(const Napi::Env& env, envelope_batch batch) {
+    auto* worker = makePromiseWorker(
+            env,
+            "MultiEncryptWrapper::decodeEnvelopes",
+            [batch = std::move(batch)] { return decode_envelope_batch(batch, true); },
+            [](const Napi::Env& env, const decoded_envelopes& decrypted) {
+                return decoded_envelopes_to_JS(env, decrypted);
+            });
+    return worker->QueuePromise();
+}
 
-        for (auto& d : decrypted) {
-            auto to_insert = Napi::Object::New(info.Env());
+Napi::Value MultiEncryptWrapper::decryptFor1o1(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        auto batch = decrypt_for_1o1_batch_from_JS(info, "decryptFor1o1");
+        return decoded_envelopes_to_JS(info.Env(), decode_envelope_batch(batch, false));
+    });
+};
 
-            to_insert.Set("decodedEnvelope", toJs(info.Env(), d));
-            to_insert.Set("messageHash", toJs(info.Env(), decryptedMessageHashes[i]));
+Napi::Value MultiEncryptWrapper::decryptForGroup(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        auto batch = decrypt_for_group_batch_from_JS(info, "decryptForGroup");
+        return decoded_envelopes_to_JS(info.Env(), decode_envelope_batch(batch, false));
+    });
+};
 
-            ret.Set(i, to_insert);
-            i++;
-        }
+Napi::Value MultiEncryptWrapper::decryptFor1o1Async(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        return decode_envelope_batch_async(
+                info.Env(), decrypt_for_1o1_batch_from_JS(info, "decryptFor1o1Async"));
+    });
+};
 
-        return ret;
+Napi::Value MultiEncryptWrapper::decryptForGroupAsync(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        return decode_envelope_batch_async(
+                info.Env(), decrypt_for_group_batch_from_JS(info, "decryptForGroupAsync"));
     });
 };
 
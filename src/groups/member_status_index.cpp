@@ -0,0 +1,82 @@
+#include "groups/member_status_index.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace session::nodeapi {
+
+const char* member_status_string(member::Status status) {
+    switch (status) {
+        // invite statuses
+        case member::Status::invite_unknown: return "INVITE_UNKNOWN";
+        case member::Status::invite_not_sent: return "INVITE_NOT_SENT";
+        case member::Status::invite_sending: return "INVITE_SENDING";
+        case member::Status::invite_failed: return "INVITE_FAILED";
+        case member::Status::invite_sent: return "INVITE_SENT";
+        case member::Status::invite_accepted: return "INVITE_ACCEPTED";
+
+        // promotion statuses
+        case member::Status::promotion_unknown: return "PROMOTION_UNKNOWN";
+        case member::Status::promotion_not_sent: return "PROMOTION_NOT_SENT";
+        case member::Status::promotion_sending: return "PROMOTION_SENDING";
+        case member::Status::promotion_failed: return "PROMOTION_FAILED";
+        case member::Status::promotion_sent: return "PROMOTION_SENT";
+        case member::Status::promotion_accepted: return "PROMOTION_ACCEPTED";
+
+        // removed statuses
+        case member::Status::removed_unknown: return "REMOVED_UNKNOWN";
+        case member::Status::removed: return "REMOVED_MEMBER";
+        case member::Status::removed_including_messages: return "REMOVED_MEMBER_AND_MESSAGES";
+
+        default: throw std::runtime_error{"Invalid member status got as an enum"};
+    }
+}
+
+uint8_t member_status_code(member::Status status) {
+    auto it = std::ranges::find(all_member_statuses, status);
+    if (it == all_member_statuses.end())
+        throw std::runtime_error{"Invalid member status got as an enum"};
+    return static_cast<uint8_t>(it - all_member_statuses.begin());
+}
+
+void MemberStatusIndex::rebuild(const Members& members) {
+    status_of_.clear();
+    by_status_.clear();
+    for (const auto& m : members) {
+        auto status = members.get_status(m);
+        status_of_.emplace(m.session_id, status);
+        by_status_[status].insert(m.session_id);
+    }
+}
+
+void MemberStatusIndex::update(const std::string& session_id, member::Status status) {
+    auto [it, inserted] = status_of_.try_emplace(session_id, status);
+    if (!inserted) {
+        if (it->second == status)
+            return;
+        by_status_[it->second].erase(session_id);
+        it->second = status;
+    }
+    by_status_[status].insert(session_id);
+}
+
+size_t MemberStatusIndex::count(member::Status status) const {
+    auto it = by_status_.find(status);
+    return it == by_status_.end() ? 0 : it->second.size();
+}
+
+std::vector<std::string> MemberStatusIndex::members_with(
+        std::span<const member::Status> statuses) const {
+    std::set<member::Status> wanted{statuses.begin(), statuses.end()};
+    std::vector<std::string> session_ids;
+    for (auto status : wanted)
+        if (auto it = by_status_.find(status); it != by_status_.end())
+            session_ids.insert(session_ids.end(), it->second.begin(), it->second.end());
+
+    // each set is sorted, but not their concatenation
+    if (wanted.size() > 1)
+        std::ranges::sort(session_ids);
+    return session_ids;
+}
+
+}  // namespace session::nodeapi
@@ -2,82 +2,128 @@
 
 #include <napi.h>
 #include <oxenc/bt_producer.h>
+#include <oxenc/hex.h>
 
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <memory>
 #include <session/types.hpp>
 #include <session/util.hpp>
 #include <span>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
 #include <vector>
 
+#include "async_worker.hpp"
+#include "change_set.hpp"
+#include "cursor.hpp"
+#include "object_shape.hpp"
+#include "parallel.hpp"
+
 namespace session::nodeapi {
 
-Napi::Object member_to_js(const Napi::Env& env, const member& info, const member::Status& status) {
-    auto obj = Napi::Object::New(env);
-
-    obj["pubkeyHex"] = toJs(env, info.session_id);
-    obj["name"] = toJs(env, info.name);
-    obj["profilePicture"] = toJs(env, info.profile_picture);
-    obj["profileUpdatedSeconds"] = toJs(env, info.profile_updated);
-    obj["supplement"] = toJs(env, info.supplement);
-
-    switch (status) {
-        // invite statuses
-        case member::Status::invite_unknown:
-            obj["memberStatus"] = toJs(env, "INVITE_UNKNOWN");
-            break;
-        case member::Status::invite_not_sent:
-            obj["memberStatus"] = toJs(env, "INVITE_NOT_SENT");
-            break;
-        case member::Status::invite_sending:
-            obj["memberStatus"] = toJs(env, "INVITE_SENDING");
-            break;
-        case member::Status::invite_failed: obj["memberStatus"] = toJs(env, "INVITE_FAILED"); break;
-        case member::Status::invite_sent: obj["memberStatus"] = toJs(env, "INVITE_SENT"); break;
-        case member::Status::invite_accepted:
-            obj["memberStatus"] = toJs(env, "INVITE_ACCEPTED");
-            break;
-
-        // promotion statuses
-        case member::Status::promotion_unknown:
-            obj["memberStatus"] = toJs(env, "PROMOTION_UNKNOWN");
-            break;
-        case member::Status::promotion_not_sent:
-            obj["memberStatus"] = toJs(env, "PROMOTION_NOT_SENT");
-            break;
-        case member::Status::promotion_sending:
-            obj["memberStatus"] = toJs(env, "PROMOTION_SENDING");
-            break;
-        case member::Status::promotion_failed:
-            obj["memberStatus"] = toJs(env, "PROMOTION_FAILED");
-            break;
-        case member::Status::promotion_sent:
-            obj["memberStatus"] = toJs(env, "PROMOTION_SENT");
-            break;
-        case member::Status::promotion_accepted:
-            obj["memberStatus"] = toJs(env, "PROMOTION_ACCEPTED");
-            break;
-
-        // removed statuses
-        case member::Status::removed_unknown:
-            obj["memberStatus"] = toJs(env, "REMOVED_UNKNOWN");
-            break;
-        case member::Status::removed: obj["memberStatus"] = toJs(env, "REMOVED_MEMBER"); break;
-        case member::Status::removed_including_messages:
-            obj["memberStatus"] = toJs(env, "REMOVED_MEMBER_AND_MESSAGES");
-            break;
-
-        default: throw std::runtime_error{"Invalid member status got as an enum"};
-    }
+static constexpr std::array pending_removal_statuses{
+        member::Status::removed_unknown,
+        member::Status::removed,
+        member::Status::removed_including_messages,
+};
 
-    // we display the "crown" on top of the member's avatar when this field is true
-    obj["nominatedAdmin"] = toJs(env, info.admin);
+// Parses an array of member status JS names (as returned by member_status_string()).
+static std::vector<member::Status> member_statuses_from_JS(
+        const Napi::Value& val, const std::string& identifier) {
+    assertIsArray(val, identifier);
+    auto arr = val.As<Napi::Array>();
+    std::vector<member::Status> statuses;
+    for (uint32_t i = 0; i < arr.Length(); i++) {
+        auto name = toCppString(arr[i], identifier);
+        auto it = std::ranges::find_if(all_member_statuses, [&name](member::Status status) {
+            return name == member_status_string(status);
+        });
+        if (it == all_member_statuses.end())
+            throw std::invalid_argument{identifier + ": unknown member status " + name};
+        statuses.push_back(*it);
+    }
+    return statuses;
+}
 
-    return obj;
-};
+// The fields of the objects members convert to; memberGetAll() and
+// memberGetAllPendingRemovals() can be given a subset of their names.
+static constexpr auto member_fields = field_table<member_entry>({
+        {"pubkeyHex",
+         [](auto& env, auto& m) -> Napi::Value { return toJs(env, m.info.session_id); }},
+        {"name", [](auto& env, auto& m) -> Napi::Value { return toJs(env, m.info.name); }},
+        {"profilePicture",
+         [](auto& env, auto& m) -> Napi::Value { return toJs(env, m.info.profile_picture); }},
+        {"profileUpdatedSeconds",
+         [](auto& env, auto& m) -> Napi::Value { return toJs(env, m.info.profile_updated); }},
+        {"supplement",
+         [](auto& env, auto& m) -> Napi::Value { return toJs(env, m.info.supplement); }},
+        {"memberStatus",
+         [](auto& env, auto& m) -> Napi::Value {
+             return interned(env, member_status_string(m.status));
+         }},
+        // we display the "crown" on top of the member's avatar when this field is true
+        {"nominatedAdmin",
+         [](auto& env, auto& m) -> Napi::Value { return toJs(env, m.info.admin); }},
+});
+
+Napi::Object member_to_js(
+        const Napi::Env& env, const member& info, const member::Status& status, FieldMask mask) {
+    return member_fields.to_js(env, member_entry{info, status}, mask);
+}
 
 MetaGroupWrapper::MetaGroupWrapper(const Napi::CallbackInfo& info) :
-        meta_group{std::move(MetaBaseWrapper::constructGroupWrapper(info, "MetaGroupWrapper"))},
-        Napi::ObjectWrap<MetaGroupWrapper>{info} {}
+        Napi::ObjectWrap<MetaGroupWrapper>{info} {
+    wrapExceptions(info, [&] {
+        if (!info.IsConstructCall())
+            throw std::invalid_argument{"You need to call the constructor with the `new` syntax"};
+
+        assertInfoLength(info, 1);
+
+        // the group loaded by createAsync() or loadMany()
+        if (auto* group = adopted<std::unique_ptr<MetaGroup>>(info)) {
+            meta_group_ = std::move(*group);
+            return;
+        }
+
+        auto args = MetaBaseWrapper::parseGroupWrapperArgs(info[0], "MetaGroupWrapper");
+        if (!args.dumped_meta) {
+            meta_group_ = MetaBaseWrapper::loadMetaGroup(args);
+            return;
+        }
+
+        // Only split the combined dump for now (so that a malformed one still throws here): the
+        // group is loaded from it by meta_group().  `dump` views into the buffer of
+        // `args.dumped_meta`, which moving it does not reallocate.
+        auto dump = MetaBaseWrapper::splitGroupDump(*args.dumped_meta);
+        dump_lacks_metadata_ = !dump.metadata;
+        pending_ = pending_group{std::move(args), std::move(dump)};
+    });
+}
+
+const MemberStatusIndex& MetaGroupWrapper::member_index() {
+    auto& members = *meta_group()->members;
+    if (member_index_epoch_ != member_status_epoch_) {
+        member_index_.rebuild(members);
+        member_index_epoch_ = member_status_epoch_;
+    }
+    return member_index_;
+}
+
+void MetaGroupWrapper::set_member(const member& m) {
+    auto& members = *meta_group()->members;
+    bool index_current = member_index_epoch_ == member_status_epoch_;
+    mutated();
+    member_statuses_changed();
+    members.set(m);
+    if (index_current) {
+        member_index_.update(m.session_id, members.get_status(m));
+        member_index_epoch_ = member_status_epoch_;
+    }
+}
 
 void MetaGroupWrapper::Init(Napi::Env env, Napi::Object exports) {
     MetaBaseWrapper::NoBaseClassInitHelper<MetaGroupWrapper>(
@@ -85,6 +131,9 @@ void MetaGroupWrapper::Init(Napi::Env env, Napi::Object exports) {
             exports,
             "MetaGroupWrapperNode",
             {
+                    StaticMethod<&MetaGroupWrapper::createAsync>("createAsync"),
+                    StaticMethod<&MetaGroupWrapper::loadMany>("loadMany"),
+
                     // shared exposed functions
                     InstanceMethod("needsPush", &MetaGroupWrapper::needsPush),
                     InstanceMethod("push", &MetaGroupWrapper::push),
@@ -94,6 +143,7 @@ void MetaGroupWrapper::Init(Napi::Env env, Napi::Object exports) {
                     InstanceMethod("metaMakeDump", &MetaGroupWrapper::metaMakeDump),
                     InstanceMethod("metaConfirmPushed", &MetaGroupWrapper::metaConfirmPushed),
                     InstanceMethod("metaMerge", &MetaGroupWrapper::metaMerge),
+                    InstanceMethod("metaMergeAsync", &MetaGroupWrapper::metaMergeAsync),
 
                     // infos exposed functions
                     InstanceMethod("infoGet", &MetaGroupWrapper::infoGet),
@@ -106,13 +156,18 @@ void MetaGroupWrapper::Init(Napi::Env env, Napi::Object exports) {
                     InstanceMethod(
                             "memberConstructAndSet", &MetaGroupWrapper::memberConstructAndSet),
                     InstanceMethod("memberGetAll", &MetaGroupWrapper::memberGetAll),
+                    InstanceMethod("memberGetAllCompact", &MetaGroupWrapper::memberGetAllCompact),
+                    InstanceMethod("memberIterate", &MetaGroupWrapper::memberIterate),
                     InstanceMethod(
                             "memberGetAllPendingRemovals",
                             &MetaGroupWrapper::memberGetAllPendingRemovals),
+                    InstanceMethod("memberCountsByStatus", &MetaGroupWrapper::memberCountsByStatus),
+                    InstanceMethod("memberGetByStatus", &MetaGroupWrapper::memberGetByStatus),
                     InstanceMethod(
                             "membersMarkPendingRemoval",
                             &MetaGroupWrapper::membersMarkPendingRemoval),
                     InstanceMethod("memberSetSupplement", &MetaGroupWrapper::memberSetSupplement),
+                    InstanceMethod("membersApply", &MetaGroupWrapper::membersApply),
                     InstanceMethod("memberSetInviteSent", &MetaGroupWrapper::memberSetInviteSent),
                     InstanceMethod(
                             "memberSetInviteNotSent", &MetaGroupWrapper::memberSetInviteNotSent),
@@ -160,40 +215,135 @@ void MetaGroupWrapper::Init(Napi::Env env, Napi::Object exports) {
             });
 }
 
+Napi::Value MetaGroupWrapper::createAsync(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 1);
+        auto args = MetaBaseWrapper::parseGroupWrapperArgs(info[0], "MetaGroupWrapper");
+        auto cls = called_class(info);
+
+        // Loading the group (parsing its dumps, and constructing and verifying its keys) is what
+        // makes constructing it slow, so that is what runs on the threadpool; the wrapper is then
+        // constructed around the loaded group.
+        auto* worker = makePromiseWorker(
+                info.Env(),
+                "MetaGroupWrapper::createAsync",
+                [args = std::move(args)] { return MetaBaseWrapper::loadMetaGroup(args); },
+                [cls = Napi::Persistent(cls)](const Napi::Env&, std::unique_ptr<MetaGroup> group) {
+                    return construct_adopting(cls.Value(), std::move(group));
+                });
+        return worker->QueuePromise();
+    });
+}
+
+// One group of loadMany(): the group loaded, or why it could not be.
+using group_load_result = std::variant<std::unique_ptr<MetaGroup>, std::string>;
+
+static constexpr ObjectShape group_load_result_shape{"group", "error"};
+
+Napi::Value MetaGroupWrapper::loadMany(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 1);
+        assertIsArray(info[0], "loadMany");
+        auto options = info[0].As<Napi::Array>();
+        auto cls = called_class(info);
+
+        // An invalid entry fails on its own, like a group failing to load: the others still load.
+        std::vector<std::variant<group_wrapper_args, std::string>> to_load;
+        to_load.reserve(options.Length());
+        for (uint32_t i = 0; i < options.Length(); i++) {
+            try {
+                to_load.emplace_back(MetaBaseWrapper::parseGroupWrapperArgs(
+                        options.Get(i), "MetaGroupWrapper.loadMany"));
+            } catch (const std::exception& e) {
+                to_load.emplace_back(std::string{e.what()});
+            }
+        }
+
+        auto* worker = makePromiseWorker(
+                info.Env(),
+                "MetaGroupWrapper::loadMany",
+                [to_load = std::move(to_load)] {
+                    std::vector<group_load_result> loaded(to_load.size());
+                    auto load_one = [&](size_t i) {
+                        if (auto* error = std::get_if<std::string>(&to_load[i])) {
+                            loaded[i] = *error;
+                            return;
+                        }
+                        try {
+                            loaded[i] = MetaBaseWrapper::loadMetaGroup(
+                                    std::get<group_wrapper_args>(to_load[i]));
+                        } catch (const std::exception& e) {
+                            loaded[i] = std::string{e.what()};
+                        }
+                    };
+                    // each item is a whole group to load, which is worth a thread of its own
+                    parallel_for(to_load.size(), load_one, 2);
+                    return loaded;
+                },
+                [cls = Napi::Persistent(cls)](
+                        const Napi::Env& env, std::vector<group_load_result> loaded) {
+                    auto results = Napi::Array::New(env, loaded.size());
+                    for (uint32_t i = 0; i < loaded.size(); i++) {
+                        Napi::Value group = env.Null();
+                        Napi::Value error = env.Null();
+                        if (auto* g = std::get_if<std::unique_ptr<MetaGroup>>(&loaded[i])) {
+                            try {
+                                group = construct_adopting(cls.Value(), std::move(*g));
+                            } catch (const std::exception& e) {
+                                error = toJs(env, std::string_view{e.what()});
+                            }
+                        } else {
+                            error = toJs(env, std::get<std::string>(loaded[i]));
+                        }
+                        results[i] = group_load_result_shape.make(env, group, error);
+                    }
+                    return results;
+                });
+        return worker->QueuePromise();
+    });
+}
+
 /* #region SHARED ACTIONS */
 
+static bool group_needs_push(const MetaGroup& group) {
+    return group.members->needs_push() || group.info->needs_push() ||
+           group.keys->pending_config();
+}
+
 Napi::Value MetaGroupWrapper::needsPush(const Napi::CallbackInfo& info) {
 
     return wrapResult(info, [&] {
-        return this->meta_group->members->needs_push() || this->meta_group->info->needs_push() ||
-               this->meta_group->keys->pending_config();
+        if (auto* metadata = pending_metadata())
+            return metadata->needs_push;
+        return group_needs_push(*meta_group());
     });
 }
 
 Napi::Value MetaGroupWrapper::push(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
+        mutated();
         auto env = info.Env();
         auto to_push = Napi::Object::New(env);
 
-        if (this->meta_group->members->needs_push())
+        if (this->meta_group()->members->needs_push())
             to_push["groupMember"s] = push_result_to_JS(
                     env,
-                    this->meta_group->members->push(),
-                    this->meta_group->members->storage_namespace());
+                    this->meta_group()->members->push(),
+                    this->meta_group()->members->storage_namespace());
         else
             to_push["groupMember"s] = env.Null();
 
-        if (this->meta_group->info->needs_push())
+        if (this->meta_group()->info->needs_push())
             to_push["groupInfo"s] = push_result_to_JS(
                     env,
-                    this->meta_group->info->push(),
-                    this->meta_group->info->storage_namespace());
+                    this->meta_group()->info->push(),
+                    this->meta_group()->info->storage_namespace());
         else
             to_push["groupInfo"s] = env.Null();
 
-        if (auto pending_config = this->meta_group->keys->pending_config())
+        if (auto pending_config = this->meta_group()->keys->pending_config())
             to_push["groupKeys"s] = push_key_entry_to_JS(
-                    env, *(pending_config), this->meta_group->keys->storage_namespace());
+                    env, *(pending_config), this->meta_group()->keys->storage_namespace());
         else
             to_push["groupKeys"s] = env.Null();
 
@@ -224,16 +374,19 @@ Napi::Value MetaGroupWrapper::push(const Napi::CallbackInfo& info) {
  */
 Napi::Value MetaGroupWrapper::pushForRecovery(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
+        mutated();
         auto env = info.Env();
         auto to_push = Napi::Object::New(env);
 
         to_push["groupMember"s] = push_result_to_JS(
                 env,
-                this->meta_group->members->push(),
-                this->meta_group->members->storage_namespace());
+                this->meta_group()->members->push(),
+                this->meta_group()->members->storage_namespace());
 
         to_push["groupInfo"s] = push_result_to_JS(
-                env, this->meta_group->info->push(), this->meta_group->info->storage_namespace());
+                env,
+                this->meta_group()->info->push(),
+                this->meta_group()->info->storage_namespace());
 
         return to_push;
     });
@@ -241,36 +394,58 @@ Napi::Value MetaGroupWrapper::pushForRecovery(const Napi::CallbackInfo& info) {
 
 Napi::Value MetaGroupWrapper::needsDump(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
-        return this->meta_group->members->needs_dump() || this->meta_group->info->needs_dump() ||
-               this->meta_group->keys->needs_dump();
+        if (dump_lacks_metadata_)
+            return true;
+        // nothing changed since the dump the group would be loaded from
+        if (pending_)
+            return false;
+        auto* group = meta_group();
+        return group->members->needs_dump() || group->info->needs_dump() ||
+               group->keys->needs_dump();
     });
 }
 
+// The metadata recorded in the combined dump of `group`, see group_dump_metadata.
+static group_dump_metadata group_metadata(const MetaGroup& group) {
+    auto info_hashes = group.info->active_hashes();
+    auto keys_hashes = group.keys->active_hashes();
+    auto members_hashes = group.members->active_hashes();
+    return {{info_hashes.begin(), info_hashes.end()},
+            {keys_hashes.begin(), keys_hashes.end()},
+            {members_hashes.begin(), members_hashes.end()},
+            group_needs_push(group)};
+}
+
 Napi::Value MetaGroupWrapper::metaDump(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
-        oxenc::bt_dict_producer combined;
-
-        // NOTE: the keys have to be in ascii-sorted order:
-        combined.append("info", session::to_string(this->meta_group->info->dump()));
-        combined.append("keys", session::to_string(this->meta_group->keys->dump()));
-        combined.append("members", session::to_string(this->meta_group->members->dump()));
-        auto to_dump = std::move(combined).str();
-
-        return session::to_vector(to_dump);
+        // not loaded, so its dump is still current
+        if (pending_metadata())
+            return *pending_->args.dumped_meta;
+
+        auto* group = meta_group();
+        auto info_dump = group->info->dump();
+        auto keys_dump = group->keys->dump();
+        auto members_dump = group->members->dump();
+        group_dump dump{info_dump, keys_dump, members_dump, group_metadata(*group)};
+        dump_lacks_metadata_ = false;
+
+        // handed over to JS as is, see toJsBuffer()
+        return MetaBaseWrapper::combineGroupDump(dump);
     });
 }
 
 Napi::Value MetaGroupWrapper::metaMakeDump(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
-        oxenc::bt_dict_producer combined;
+        if (pending_metadata())
+            return *pending_->args.dumped_meta;
 
-        // NOTE: the keys have to be in ascii-sorted order:
-        combined.append("info", session::to_string(this->meta_group->info->make_dump()));
-        combined.append("keys", session::to_string(this->meta_group->keys->make_dump()));
-        combined.append("members", session::to_string(this->meta_group->members->make_dump()));
-        auto to_dump = std::move(combined).str();
+        auto* group = meta_group();
+        auto info_dump = group->info->make_dump();
+        auto keys_dump = group->keys->make_dump();
+        auto members_dump = group->members->make_dump();
+        group_dump dump{info_dump, keys_dump, members_dump, group_metadata(*group)};
 
-        return session::to_vector(to_dump);
+        return MetaBaseWrapper::combineGroupDump(dump);
     });
 }
 
@@ -289,7 +464,7 @@ void MetaGroupWrapper::metaConfirmPushed(const Napi::CallbackInfo& info) {
             auto groupInfoObj = groupInfo.As<Napi::Object>();
             auto groupInfoConfirmed = confirm_pushed_entry_from_JS(info.Env(), groupInfoObj);
 
-            this->meta_group->info->confirm_pushed(
+            this->meta_group()->info->confirm_pushed(
                     std::get<0>(groupInfoConfirmed), std::get<1>(groupInfoConfirmed));
         }
 
@@ -298,113 +473,179 @@ void MetaGroupWrapper::metaConfirmPushed(const Napi::CallbackInfo& info) {
             auto groupMemberObj = groupMember.As<Napi::Object>();
             auto groupMemberConfirmed = confirm_pushed_entry_from_JS(info.Env(), groupMemberObj);
 
-            this->meta_group->members->confirm_pushed(
+            mutated();
+            this->meta_group()->members->confirm_pushed(
                     std::get<0>(groupMemberConfirmed), std::get<1>(groupMemberConfirmed));
         }
     });
 };
 
+// Parses one of the `groupKeys`/`groupInfo`/`groupMember` arrays given to metaMerge into
+// `entries`, returning the array (empty for a null or undefined value) for any further parsing.
+static Napi::Array meta_merge_entries_from_JS(
+        const Napi::Value& val, const std::string& name, merge_entries& entries, bool copy) {
+    if (val.IsNull() || val.IsUndefined())
+        return Napi::Array::New(val.Env(), 0);
+
+    assertIsArray(val, "metaMerge " + name);
+    auto asArr = val.As<Napi::Array>();
+    entries.configs.reserve(asArr.Length());
+    if (copy)
+        entries.owned.reserve(asArr.Length());
+
+    for (uint32_t i = 0; i < asArr.Length(); i++) {
+        Napi::Value item = asArr[i];
+        assertIsObject(item);
+        if (item.IsEmpty())
+            throw std::invalid_argument("MetaMerge.item " + name + " received empty");
+
+        Napi::Object itemObject = item.As<Napi::Object>();
+        assertIsString(itemObject.Get("hash"));
+        assertIsUInt8Array(itemObject.Get("data"), name + " merge");
+        entries.add(
+                toCppString(itemObject.Get("hash"), "meta.merge " + name + " hash"),
+                itemObject.Get("data"),
+                copy,
+                "meta.merge " + name + " data");
+    }
+    return asArr;
+}
+
+meta_merge_input meta_merge_input_from_JS(const Napi::Value& arg, bool copy) {
+    assertIsObject(arg);
+    auto obj = arg.As<Napi::Object>();
+
+    meta_merge_input input;
+
+    auto keysArr = meta_merge_entries_from_JS(obj.Get("groupKeys"), "groupKeys", input.keys, copy);
+    input.keys_timestamp_ms.reserve(keysArr.Length());
+    for (uint32_t i = 0; i < keysArr.Length(); i++) {
+        auto timestampMs = keysArr.Get(i).As<Napi::Object>().Get("timestampMs");
+        assertIsNumber(timestampMs, "timestampMs groupKeys");
+        input.keys_timestamp_ms.push_back(
+                toCppInteger(timestampMs, "meta.merge keys timestampMs", false));
+    }
+
+    meta_merge_entries_from_JS(obj.Get("groupInfo"), "groupInfo", input.info, copy);
+    meta_merge_entries_from_JS(obj.Get("groupMember"), "groupMember", input.members, copy);
+    return input;
+}
+
+meta_merge_result meta_merge(MetaGroup& group, const meta_merge_input& input) {
+    meta_merge_result result;
+
+    // Note: we need to process keys first as they might allow us the incoming info+members
+    // details
+    for (size_t i = 0; i < input.keys.size(); i++) {
+        const auto& [hash, data] = input.keys.configs[i];
+        group.keys->load_key_message(
+                hash, data, input.keys_timestamp_ms[i], *group.info, *group.members);
+        result.count++;  // load_key_message doesn't necessarily merge something as not all keys
+                         // are for us.
+    }
+
+    if (!input.info.empty())
+        result.count += group.info->merge(input.info.configs).size();
+    if (!input.members.empty())
+        result.count += group.members->merge(input.members.configs).size();
+
+    if (group.keys->needs_rekey()) {
+        group.keys->rekey(*group.info, *group.members);
+        result.rekeyed = true;
+    }
+    return result;
+}
+
+// The key and fingerprint of a member, for the change sets of metaMerge().
+static std::pair<std::string, uint64_t> member_fingerprint(
+        const Members& members, const member& m) {
+    Fingerprint fp;
+    fp.add(m.name, m.profile_picture.url, m.profile_picture.key, m.profile_updated);
+    fp.add(m.supplement, m.admin, members.get_status(m));
+    return {m.session_id, fp.value()};
+}
+
+// The fingerprints of the members, as the "member" collection of the change sets of metaMerge().
+static config_fingerprints member_fingerprints(const Members& members) {
+    auto fingerprint = [&members](const member& m) { return member_fingerprint(members, m); };
+    return {{"member", fingerprint_all(members.begin(), members.end(), fingerprint)}};
+}
+
+// The outcome of metaMerge() and metaMergeAsync(), with the change set of the members if requested.
+struct meta_merge_outcome {
+    meta_merge_result result;
+    std::optional<config_changes> changes;
+};
+
+// meta_merge(), computing the change set of the members from their fingerprints before and after
+// if `with_changes`.  Touches no JS value, so this can run off the main thread.
+static meta_merge_outcome meta_merge_with_changes(
+        MetaGroup& group, const meta_merge_input& input, bool with_changes) {
+    std::optional<config_fingerprints> before;
+    if (with_changes)
+        before = member_fingerprints(*group.members);
+
+    meta_merge_outcome outcome{meta_merge(group, input)};
+    if (with_changes)
+        outcome.changes = diff_fingerprints(*before, member_fingerprints(*group.members));
+    return outcome;
+}
+
+static constexpr ObjectShape meta_merge_changes_shape{"count", "changes"};
+
 Napi::Value MetaGroupWrapper::metaMerge(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] {
-        assertInfoLength(info, 1);
-        auto arg = info[0];
-        assertIsObject(arg);
-        auto obj = arg.As<Napi::Object>();
-        auto groupInfo = obj.Get("groupInfo");
-        auto groupMember = obj.Get("groupMember");
-        auto groupKeys = obj.Get("groupKeys");
-
-        auto count_merged = 0;
-
-        // Note: we need to process keys first as they might allow us the incoming info+members
-        // details
-        if (!groupKeys.IsNull() && !groupKeys.IsUndefined()) {
-            assertIsArray(groupKeys, "metaMerge groupKeys");
-            auto asArr = groupKeys.As<Napi::Array>();
-
-            for (uint32_t i = 0; i < asArr.Length(); i++) {
-                Napi::Value item = asArr[i];
-                assertIsObject(item);
-                if (item.IsEmpty())
-                    throw std::invalid_argument("MetaMerge.item groupKeys received empty");
-
-                Napi::Object itemObject = item.As<Napi::Object>();
-                assertIsString(itemObject.Get("hash"));
-                assertIsUInt8Array(itemObject.Get("data"), "groupKeys merge");
-                assertIsNumber(itemObject.Get("timestampMs"), "timestampMs groupKeys");
-
-                auto hash = toCppString(itemObject.Get("hash"), "meta.merge keys hash");
-                auto data = toCppBuffer(itemObject.Get("data"), "meta.merge keys data");
-                auto timestamp_ms = toCppInteger(
-                        itemObject.Get("timestampMs"), "meta.merge keys timestampMs", false);
-
-                this->meta_group->keys->load_key_message(
-                        hash,
-                        data,
-                        timestamp_ms,
-                        *(this->meta_group->info),
-                        *(this->meta_group->members));
-                count_merged++;  // load_key_message doesn't necessarily merge something as not
-                                 // all keys are for us.
-            }
-        }
+    return wrapResult(info, [&]() -> Napi::Value {
+        checkOrThrow(info.Length() >= 1 && info.Length() <= 2, "Invalid number of arguments");
+        auto input = meta_merge_input_from_JS(info[0], false);
+        bool with_changes = change_set_requested(info[1]);
 
-        if (!groupInfo.IsNull() && !groupInfo.IsUndefined()) {
-            assertIsArray(groupInfo, "metaMerge groupInfo");
-            auto asArr = groupInfo.As<Napi::Array>();
-
-            std::vector<std::pair<std::string, std::vector<unsigned char>>> conf_strs;
-            conf_strs.reserve(asArr.Length());
-
-            for (uint32_t i = 0; i < asArr.Length(); i++) {
-                Napi::Value item = asArr[i];
-                assertIsObject(item);
-                if (item.IsEmpty())
-                    throw std::invalid_argument("MetaMerge.item groupInfo received empty");
-
-                Napi::Object itemObject = item.As<Napi::Object>();
-                assertIsString(itemObject.Get("hash"));
-                assertIsUInt8Array(itemObject.Get("data"), "groupInfo merge");
-                conf_strs.emplace_back(
-                        toCppString(itemObject.Get("hash"), "meta.merge"),
-                        toCppBuffer(itemObject.Get("data"), "meta.merge"));
-            }
+        auto& group = *meta_group();
+        mutated();
+        member_statuses_changed();
+        auto outcome = meta_merge_with_changes(group, input, with_changes);
 
-            if (conf_strs.size()) {
-                auto info_merged = this->meta_group->info->merge(conf_strs);
-                count_merged += info_merged.size();
-            }
-        }
-        if (!groupMember.IsNull() && !groupMember.IsUndefined()) {
-            assertIsArray(groupMember, "metaMerge groupMember");
-            auto asArr = groupMember.As<Napi::Array>();
-
-            std::vector<std::pair<std::string, std::vector<unsigned char>>> conf_strs;
-            conf_strs.reserve(asArr.Length());
-
-            for (uint32_t i = 0; i < asArr.Length(); i++) {
-                Napi::Value item = asArr[i];
-                assertIsObject(item);
-                if (item.IsEmpty())
-                    throw std::invalid_argument("MetaMerge.item groupMember received empty");
-
-                Napi::Object itemObject = item.As<Napi::Object>();
-                assertIsString(itemObject.Get("hash"));
-                assertIsUInt8Array(itemObject.Get("data"), "groupMember merge");
-                conf_strs.emplace_back(
-                        toCppString(itemObject.Get("hash"), "meta.merge"),
-                        toCppBuffer(itemObject.Get("data"), "meta.merge"));
-            }
+        auto env = info.Env();
+        if (!outcome.changes)
+            return toJs(env, outcome.result.count);
+        return meta_merge_changes_shape.make(
+                env, toJs(env, outcome.result.count), toJs(env, *outcome.changes));
+    });
+}
 
-            if (conf_strs.size()) {
-                auto member_merged = this->meta_group->members->merge(conf_strs);
-                count_merged += member_merged.size();
-            }
-        }
-        if (this->meta_group->keys->needs_rekey()) {
-            this->meta_group->keys->rekey(*(this->meta_group->info), *(this->meta_group->members));
-        }
-        return count_merged;
+static constexpr ObjectShape meta_merge_async_changes_shape{"count", "rekeyed", "changes"};
+
+Napi::Value MetaGroupWrapper::metaMergeAsync(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        checkOrThrow(info.Length() >= 1 && info.Length() <= 2, "Invalid number of arguments");
+        auto input = meta_merge_input_from_JS(info[0], true);
+        bool with_changes = change_set_requested(info[1]);
+        auto* group = meta_group();
+
+        // `group` is owned by this wrapper, which the worker keeps alive until it settles; every
+        // other method refuses to touch it (through meta_group()) in the meantime, so the job can
+        // also take the fingerprints of the change set, if requested.
+        auto* worker = makePromiseWorker(
+                info.Env(),
+                "MetaGroupWrapper::metaMergeAsync",
+                [group, input = std::move(input), with_changes] {
+                    return meta_merge_with_changes(*group, input, with_changes);
+                },
+                [](const Napi::Env& env, const meta_merge_outcome& outcome) -> Napi::Value {
+                    if (!outcome.changes)
+                        return toJs(env, outcome.result);
+                    return meta_merge_async_changes_shape.make(
+                            env,
+                            toJs(env, outcome.result.count),
+                            toJs(env, outcome.result.rekeyed),
+                            toJs(env, *outcome.changes));
+                });
+        worker->OnSettled([this] { busy_ = false; });
+        worker->KeepAlive(info.This().As<Napi::Object>());
+
+        busy_ = true;
+        mutated();
+        member_statuses_changed();
+        return worker->QueuePromise();
     });
 }
 
@@ -417,20 +658,20 @@ Napi::Value MetaGroupWrapper::infoGet(const Napi::CallbackInfo& info) {
         auto env = info.Env();
         auto obj = Napi::Object::New(env);
 
-        obj["name"] = toJs(env, this->meta_group->info->get_name());
-        obj["createdAtSeconds"] = toJs(env, this->meta_group->info->get_created());
+        obj["name"] = toJs(env, this->meta_group()->info->get_name());
+        obj["createdAtSeconds"] = toJs(env, this->meta_group()->info->get_created());
         obj["deleteAttachBeforeSeconds"] =
-                toJs(env, this->meta_group->info->get_delete_attach_before());
-        obj["deleteBeforeSeconds"] = toJs(env, this->meta_group->info->get_delete_before());
+                toJs(env, this->meta_group()->info->get_delete_attach_before());
+        obj["deleteBeforeSeconds"] = toJs(env, this->meta_group()->info->get_delete_before());
 
-        if (auto expiry = this->meta_group->info->get_expiry_timer(); expiry)
+        if (auto expiry = this->meta_group()->info->get_expiry_timer(); expiry)
             obj["expirySeconds"] = toJs(env, expiry->count());
         else
             obj["expirySeconds"] = env.Null();
 
-        obj["isDestroyed"] = toJs(env, this->meta_group->info->is_destroyed());
-        obj["profilePicture"] = toJs(env, this->meta_group->info->get_profile_pic());
-        obj["description"] = toJs(env, this->meta_group->info->get_description().value_or(""));
+        obj["isDestroyed"] = toJs(env, this->meta_group()->info->is_destroyed());
+        obj["profilePicture"] = toJs(env, this->meta_group()->info->get_profile_pic());
+        obj["description"] = toJs(env, this->meta_group()->info->get_description().value_or(""));
 
         return obj;
     });
@@ -445,28 +686,28 @@ Napi::Value MetaGroupWrapper::infoSet(const Napi::CallbackInfo& info) {
 
         // we want to not throw if the name is too long, but just truncate it
         if (auto name = maybeNonemptyString(obj.Get("name"), "MetaGroupWrapper::setInfo name"))
-            this->meta_group->info->set_name_truncated(*name);
+            this->meta_group()->info->set_name_truncated(*name);
 
         if (auto created = maybeNonemptyInt(
                     obj.Get("createdAtSeconds"), "MetaGroupWrapper::setInfo set_created"))
-            this->meta_group->info->set_created(std::move(*created));
+            this->meta_group()->info->set_created(std::move(*created));
 
         if (auto expiry = maybeNonemptyInt(
                     obj.Get("expirySeconds"), "MetaGroupWrapper::setInfo set_expiry_timer"))
-            this->meta_group->info->set_expiry_timer(std::chrono::seconds{*expiry});
+            this->meta_group()->info->set_expiry_timer(std::chrono::seconds{*expiry});
 
         if (auto deleteBefore = maybeNonemptyInt(
                     obj.Get("deleteBeforeSeconds"), "MetaGroupWrapper::setInfo set_delete_before"))
-            this->meta_group->info->set_delete_before(std::move(*deleteBefore));
+            this->meta_group()->info->set_delete_before(std::move(*deleteBefore));
 
         if (auto deleteAttachBefore = maybeNonemptyInt(
                     obj.Get("deleteAttachBeforeSeconds"),
                     "MetaGroupWrapper::setInfo set_delete_attach_before"))
-            this->meta_group->info->set_delete_attach_before(std::move(*deleteAttachBefore));
+            this->meta_group()->info->set_delete_attach_before(std::move(*deleteAttachBefore));
 
         if (auto profilePicture = obj.Get("profilePicture")) {
             auto profilePic = profile_pic_from_object(profilePicture);
-            this->meta_group->info->set_profile_pic(profilePic);
+            this->meta_group()->info->set_profile_pic(profilePic);
         }
 
         // Note: maybeNonemptyString returns nullopt when the string is null, undefined or empty.
@@ -476,7 +717,7 @@ Napi::Value MetaGroupWrapper::infoSet(const Napi::CallbackInfo& info) {
         // Because of this custom behavior, we need those manual checks in place.
         if (auto description = obj.Get("description")) {
             if (description.IsString()) {
-                this->meta_group->info->set_description_truncated(
+                this->meta_group()->info->set_description_truncated(
                         description.ToString().Utf8Value());
             }
         }
@@ -487,7 +728,7 @@ Napi::Value MetaGroupWrapper::infoSet(const Napi::CallbackInfo& info) {
 
 Napi::Value MetaGroupWrapper::infoDestroy(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
-        meta_group->info->destroy_group();
+        meta_group()->info->destroy_group();
         return this->infoGet(info);
     });
 }
@@ -498,28 +739,113 @@ Napi::Value MetaGroupWrapper::infoDestroy(const Napi::CallbackInfo& info) {
 
 Napi::Value MetaGroupWrapper::memberGetAll(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
+        checkOrThrow(info.Length() <= 1, "Invalid number of arguments");
+        auto convert = member_fields.converter(info.Env(), member_fields.mask_from_JS(info[0]));
+        Members& members = *meta_group()->members;
         std::vector<Napi::Object> allMembersJs;
-        for (auto& member : *this->meta_group->members) {
-            allMembersJs.push_back(
-                    member_to_js(info.Env(), member, meta_group->members->get_status(member)));
-        }
+        for (auto& member : members)
+            allMembersJs.push_back(convert(member_entry{member, members.get_status(member)}));
         return allMembersJs;
     });
 }
 
+// Converts the members `session_ids`, as listed by the status index, to JS.
+static std::vector<Napi::Object> members_to_js(
+        const Napi::Env& env,
+        const Members& members,
+        const std::vector<std::string>& session_ids,
+        FieldMask mask) {
+    auto convert = member_fields.converter(env, mask);
+    std::vector<Napi::Object> result;
+    result.reserve(session_ids.size());
+    for (const auto& session_id : session_ids)
+        if (auto m = members.get(session_id))
+            result.push_back(convert(member_entry{*m, members.get_status(*m)}));
+    return result;
+}
+
 Napi::Value MetaGroupWrapper::memberGetAllPendingRemovals(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
-        std::vector<Napi::Object> allMembersRemovedJs;
-        for (auto& member : *this->meta_group->members) {
-            auto memberStatus = this->meta_group->members->get_status(member);
-            if (memberStatus == member::Status::removed_unknown ||
-                memberStatus == member::Status::removed ||
-                memberStatus == member::Status::removed_including_messages) {
-                allMembersRemovedJs.push_back(
-                        member_to_js(info.Env(), member, meta_group->members->get_status(member)));
-            }
+        checkOrThrow(info.Length() <= 1, "Invalid number of arguments");
+        auto mask = member_fields.mask_from_JS(info[0]);
+        return members_to_js(
+                info.Env(),
+                *meta_group()->members,
+                member_index().members_with(pending_removal_statuses),
+                mask);
+    });
+}
+
+Napi::Value MetaGroupWrapper::memberCountsByStatus(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 0);
+        static const auto names = [] {
+            std::array<const char*, all_member_statuses.size()> names;
+            for (size_t i = 0; i < names.size(); i++)
+                names[i] = member_status_string(all_member_statuses[i]);
+            return names;
+        }();
+
+        auto env = info.Env();
+        const auto& index = member_index();
+        std::array<napi_value, all_member_statuses.size()> counts;
+        for (size_t i = 0; i < counts.size(); i++)
+            counts[i] = toJs(env, index.count(all_member_statuses[i]));
+        return define_object(env, interned_keys(env, names), counts);
+    });
+}
+
+Napi::Value MetaGroupWrapper::memberGetByStatus(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        checkOrThrow(info.Length() >= 1 && info.Length() <= 2, "Invalid number of arguments");
+        auto statuses = member_statuses_from_JS(info[0], "memberGetByStatus");
+        auto mask = member_fields.mask_from_JS(info[1]);
+        return members_to_js(
+                info.Env(), *meta_group()->members, member_index().members_with(statuses), mask);
+    });
+}
+
+static constexpr ObjectShape member_compact_shape{"count", "pubkeys", "statuses"};
+
+Napi::Value MetaGroupWrapper::memberGetAllCompact(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 0);
+        auto env = info.Env();
+        Members& members = *meta_group()->members;
+        size_t count = members.size();
+
+        auto pubkeys = Napi::Uint8Array::New(env, count * 33);
+        auto statuses = Napi::Uint8Array::New(env, count);
+        size_t i = 0;
+        for (auto it = members.begin(); it != members.end() && i < count; ++it, ++i) {
+            const member& m = *it;
+            oxenc::from_hex(m.session_id.begin(), m.session_id.end(), pubkeys.Data() + i * 33);
+            statuses[i] = member_status_code(members.get_status(m));
         }
-        return allMembersRemovedJs;
+        return member_compact_shape.make(env, toJs(env, count), pubkeys, statuses);
+    });
+}
+
+Napi::Value MetaGroupWrapper::memberIterate(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        checkOrThrow(info.Length() <= 1, "Invalid number of arguments");
+        auto opts = cursor_options_from_JS(info[0]);
+        if (opts.type)
+            throw std::invalid_argument{"memberIterate: members have no `type` to choose"};
+
+        Members& members = *meta_group()->members;
+        return make_cursor(
+                info,
+                cursor_guard(),
+                opts.batch_size,
+                members.begin(),
+                members.end(),
+                [&members, mask = member_fields.mask_from_JS(opts.fields)](const Napi::Env& env) {
+                    auto convert = member_fields.converter(env, mask);
+                    return [&members, convert](const member& m) {
+                        return convert(member_entry{m, members.get_status(m)});
+                    };
+                });
     });
 }
 
@@ -529,10 +855,12 @@ Napi::Value MetaGroupWrapper::memberGet(const Napi::CallbackInfo& info) {
         assertIsString(info[0]);
 
         auto pubkeyHex = toCppString(info[0], "memberGet");
-        auto existing = meta_group->members->get(pubkeyHex);
+        auto existing = meta_group()->members->get(pubkeyHex);
 
         return existing ? member_to_js(
-                                  info.Env(), *existing, meta_group->members->get_status(*existing))
+                                  info.Env(),
+                                  *existing,
+                                  meta_group()->members->get_status(*existing))
                         : info.Env().Null();
     });
 }
@@ -543,8 +871,8 @@ Napi::Value MetaGroupWrapper::memberGetOrConstruct(const Napi::CallbackInfo& inf
         assertIsString(info[0]);
 
         auto pubkeyHex = toCppString(info[0], "memberGetOrConstruct");
-        auto created = meta_group->members->get_or_construct(pubkeyHex);
-        return member_to_js(info.Env(), created, meta_group->members->get_status(created));
+        auto created = meta_group()->members->get_or_construct(pubkeyHex);
+        return member_to_js(info.Env(), created, meta_group()->members->get_status(created));
     });
 }
 
@@ -554,9 +882,9 @@ Napi::Value MetaGroupWrapper::memberConstructAndSet(const Napi::CallbackInfo& in
         assertIsString(info[0]);
 
         auto pubkeyHex = toCppString(info[0], "memberConstructAndSet");
-        auto created = meta_group->members->get_or_construct(pubkeyHex);
-        meta_group->members->set(created);
-        return member_to_js(info.Env(), created, meta_group->members->get_status(created));
+        auto created = meta_group()->members->get_or_construct(pubkeyHex);
+        set_member(created);
+        return member_to_js(info.Env(), created, meta_group()->members->get_status(created));
     });
 }
 
@@ -565,10 +893,10 @@ void MetaGroupWrapper::memberSetSupplement(const Napi::CallbackInfo& info) {
         assertIsString(info[0]);
 
         auto pubkeyHex = toCppString(info[0], "memberSetSupplement pubkeyHex");
-        auto m = this->meta_group->members->get(pubkeyHex);
+        auto m = this->meta_group()->members->get(pubkeyHex);
         if (m) {
             m->supplement = true;
-            this->meta_group->members->set(*m);
+            set_member(*m);
         }
     });
 }
@@ -578,10 +906,10 @@ void MetaGroupWrapper::memberSetInviteFailed(const Napi::CallbackInfo& info) {
         assertIsString(info[0]);
         auto pubkeyHex = toCppString(info[0], "memberSetInviteFailed");
 
-        auto m = this->meta_group->members->get(pubkeyHex);
+        auto m = this->meta_group()->members->get(pubkeyHex);
         if (m) {
             m->set_invite_failed();
-            this->meta_group->members->set(*m);
+            set_member(*m);
         }
     });
 }
@@ -591,10 +919,10 @@ void MetaGroupWrapper::memberSetInviteSent(const Napi::CallbackInfo& info) {
         assertIsString(info[0]);
         auto pubkeyHex = toCppString(info[0], "memberSetInviteSent");
 
-        auto m = this->meta_group->members->get(pubkeyHex);
+        auto m = this->meta_group()->members->get(pubkeyHex);
         if (m) {
             m->set_invite_sent();
-            this->meta_group->members->set(*m);
+            set_member(*m);
         }
     });
 }
@@ -604,10 +932,10 @@ void MetaGroupWrapper::memberSetInviteNotSent(const Napi::CallbackInfo& info) {
         assertIsString(info[0]);
         auto pubkeyHex = toCppString(info[0], "memberSetInviteNotSent");
 
-        auto m = this->meta_group->members->get(pubkeyHex);
+        auto m = this->meta_group()->members->get(pubkeyHex);
         if (m) {
             m->set_invite_not_sent();
-            this->meta_group->members->set(*m);
+            set_member(*m);
         }
     });
 }
@@ -618,10 +946,10 @@ void MetaGroupWrapper::memberSetInviteAccepted(const Napi::CallbackInfo& info) {
         assertIsString(info[0]);
 
         auto pubkeyHex = toCppString(info[0], "memberSetInviteAccepted");
-        auto m = this->meta_group->members->get(pubkeyHex);
+        auto m = this->meta_group()->members->get(pubkeyHex);
         if (m) {
             m->set_invite_accepted();
-            this->meta_group->members->set(*m);
+            set_member(*m);
         }
     });
 }
@@ -631,10 +959,10 @@ void MetaGroupWrapper::memberSetPromoted(const Napi::CallbackInfo& info) {
         assertInfoLength(info, 1);
         assertIsString(info[0]);
         auto pubkeyHex = toCppString(info[0], "memberSetPromoted");
-        auto m = this->meta_group->members->get(pubkeyHex);
+        auto m = this->meta_group()->members->get(pubkeyHex);
         if (m) {
             m->set_promoted();
-            this->meta_group->members->set(*m);
+            set_member(*m);
         }
     });
 }
@@ -644,10 +972,10 @@ void MetaGroupWrapper::memberSetPromotionSent(const Napi::CallbackInfo& info) {
         assertInfoLength(info, 1);
         assertIsString(info[0]);
         auto pubkeyHex = toCppString(info[0], "memberSetPromotionSent");
-        auto m = this->meta_group->members->get(pubkeyHex);
+        auto m = this->meta_group()->members->get(pubkeyHex);
         if (m) {
             m->set_promotion_sent();
-            this->meta_group->members->set(*m);
+            set_member(*m);
         }
     });
 }
@@ -657,10 +985,10 @@ void MetaGroupWrapper::memberSetPromotionFailed(const Napi::CallbackInfo& info)
         assertInfoLength(info, 1);
         assertIsString(info[0]);
         auto pubkeyHex = toCppString(info[0], "memberSetPromotionFailed");
-        auto m = this->meta_group->members->get(pubkeyHex);
+        auto m = this->meta_group()->members->get(pubkeyHex);
         if (m) {
             m->set_promotion_failed();
-            this->meta_group->members->set(*m);
+            set_member(*m);
         }
     });
 }
@@ -670,14 +998,21 @@ void MetaGroupWrapper::memberSetPromotionAccepted(const Napi::CallbackInfo& info
         assertInfoLength(info, 1);
         assertIsString(info[0]);
         auto pubkeyHex = toCppString(info[0], "memberSetPromotionAccepted");
-        auto m = this->meta_group->members->get(pubkeyHex);
+        auto m = this->meta_group()->members->get(pubkeyHex);
         if (m) {
             m->set_promotion_accepted();
-            this->meta_group->members->set(*m);
+            set_member(*m);
         }
     });
 }
 
+// Whether profile details updated at `updated` should replace those of `m`: if they are more recent
+// than the ones saved.  We also allow anything when our current value is 0, as it means we haven't
+// got an updated profileDetails yet.
+static bool profile_is_newer(const member& m, std::chrono::sys_seconds updated) {
+    return updated > m.profile_updated || m.profile_updated.time_since_epoch().count() == 0;
+}
+
 void MetaGroupWrapper::memberSetProfileDetails(const Napi::CallbackInfo& info) {
     wrapExceptions(info, [&] {
         assertInfoLength(info, 2);
@@ -686,16 +1021,12 @@ void MetaGroupWrapper::memberSetProfileDetails(const Napi::CallbackInfo& info) {
 
         auto pubkeyHex = toCppString(info[0], "memberSetProfileDetails");
 
-        auto m = this->meta_group->members->get(pubkeyHex);
+        auto m = this->meta_group()->members->get(pubkeyHex);
         auto argsAsObj = info[1].As<Napi::Object>();
         auto updatedAtSeconds =
                 toCppSysSeconds(argsAsObj.Get("profileUpdatedSeconds"), "memberSetProfileDetails");
 
-        // if the profile details provided are more recent that the ones saved, update them.
-        // we also allow anything when our current value is 0, as it means we haven't got an updated
-        // profileDetails yet
-        if (m && (updatedAtSeconds > m->profile_updated ||
-                  m->profile_updated.time_since_epoch().count() == 0)) {
+        if (m && profile_is_newer(*m, updatedAtSeconds)) {
             m->profile_updated = updatedAtSeconds;
 
             auto profilePicture = profile_pic_from_object(argsAsObj.Get("profilePicture"));
@@ -705,21 +1036,137 @@ void MetaGroupWrapper::memberSetProfileDetails(const Napi::CallbackInfo& info) {
             auto newName = toCppString(argsAsObj.Get("name"), "memberSetProfileDetails newName");
             m->set_name_truncated(newName);
 
-            this->meta_group->members->set(*m);
+            set_member(*m);
+        }
+    });
+}
+
+// A parsed membersApply() change, applied to the member it targets.  Returns false if it was not
+// applicable (e.g. older profile details), like the memberSetXxx() method that then saves nothing.
+using member_update = std::function<bool(member&)>;
+
+// Parses the change object of a membersApply() op (reading any extra field it has) into its update.
+using member_op_parser = member_update (*)(const Napi::Object& change);
+
+template <void (member::*Setter)()>
+static member_update call_setter(const Napi::Object&) {
+    return [](member& m) {
+        (m.*Setter)();
+        return true;
+    };
+}
+
+static member_update set_supplement(const Napi::Object&) {
+    return [](member& m) {
+        m.supplement = true;
+        return true;
+    };
+}
+
+static member_update set_pending_removal(const Napi::Object& change) {
+    bool with_messages = toCppBoolean(change.Get("withMessages"), "membersApply withMessages");
+    return [with_messages](member& m) {
+        m.set_removed(with_messages);
+        return true;
+    };
+}
+
+// Same as memberSetProfileDetails().
+static member_update set_profile_details(const Napi::Object& change) {
+    auto updated = toCppSysSeconds(
+            change.Get("profileUpdatedSeconds"), "membersApply profileUpdatedSeconds");
+    auto pic = profile_pic_from_object(change.Get("profilePicture"));
+    auto name = toCppString(change.Get("name"), "membersApply name");
+    return [updated, pic = std::move(pic), name = std::move(name)](member& m) {
+        if (!profile_is_newer(m, updated))
+            return false;
+        m.profile_updated = updated;
+        m.profile_picture = pic;
+        // this will truncate silently if the name is too long
+        m.set_name_truncated(name);
+        return true;
+    };
+}
+
+// The ops of membersApply(), by their JS name; each does what the memberSetXxx() method of the same
+// name does.
+static const std::unordered_map<std::string_view, member_op_parser> member_ops{
+        {"inviteSent", call_setter<&member::set_invite_sent>},
+        {"inviteNotSent", call_setter<&member::set_invite_not_sent>},
+        {"inviteFailed", call_setter<&member::set_invite_failed>},
+        {"inviteAccepted", call_setter<&member::set_invite_accepted>},
+        {"promoted", call_setter<&member::set_promoted>},
+        {"promotionSent", call_setter<&member::set_promotion_sent>},
+        {"promotionFailed", call_setter<&member::set_promotion_failed>},
+        {"promotionAccepted", call_setter<&member::set_promotion_accepted>},
+        {"supplement", set_supplement},
+        {"profileDetails", set_profile_details},
+        {"pendingRemoval", set_pending_removal},
+};
+
+Napi::Value MetaGroupWrapper::membersApply(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 1);
+        assertIsArray(info[0], "membersApply");
+        auto changes = info[0].As<Napi::Array>();
+
+        // Parse everything first, so that an invalid change applies none of them.  The updates are
+        // grouped by member, in order, so that each member is fetched and saved only once.
+        std::vector<std::pair<std::string, std::vector<member_update>>> updates;
+        std::unordered_map<std::string, size_t> update_index;
+        for (uint32_t i = 0; i < changes.Length(); i++) {
+            Napi::Value change_val = changes[i];
+            assertIsObject(change_val);
+            auto change = change_val.As<Napi::Object>();
+            auto pubkey_hex = toCppString(change.Get("pubkeyHex"), "membersApply pubkeyHex");
+            auto op = toCppString(change.Get("op"), "membersApply op");
+            auto parser = member_ops.find(op);
+            if (parser == member_ops.end())
+                throw std::invalid_argument{"membersApply: unknown op " + op};
+
+            auto [it, inserted] = update_index.try_emplace(pubkey_hex, updates.size());
+            if (inserted)
+                updates.emplace_back(pubkey_hex, std::vector<member_update>{});
+            updates[it->second].second.push_back(parser->second(change));
+        }
+
+        // Like the memberSetXxx() methods, this ignores the changes to unknown members, and saves a
+        // member whenever a change was applied to it.  Those members are returned.
+        Members& members = *meta_group()->members;
+        std::vector<std::string> changed;
+        for (auto& [pubkey_hex, member_updates] : updates) {
+            auto m = members.get(pubkey_hex);
+            if (!m)
+                continue;
+
+            bool applied = false;
+            for (auto& update : member_updates)
+                applied |= update(*m);
+            if (!applied)
+                continue;
+
+            set_member(*m);
+            changed.push_back(pubkey_hex);
         }
+        return changed;
     });
 }
 
 Napi::Value MetaGroupWrapper::memberResetAllSendingState(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
         bool changed = false;
-        for (auto& member : *this->meta_group->members) {
-            auto sending = this->meta_group->members->has_pending_send(member.session_id);
+        for (auto& member : *this->meta_group()->members) {
+            auto sending = this->meta_group()->members->has_pending_send(member.session_id);
             if (sending) {
-                this->meta_group->members->set_pending_send(member.session_id, false);
+                this->meta_group()->members->set_pending_send(member.session_id, false);
                 changed = true;
             }
         }
+        // that changed the statuses of those members
+        if (changed) {
+            mutated();
+            member_statuses_changed();
+        }
         return changed;
     });
 }
@@ -737,10 +1184,10 @@ void MetaGroupWrapper::membersMarkPendingRemoval(const Napi::CallbackInfo& info)
         auto toUpdateJS = toUpdateJSValue.As<Napi::Array>();
         for (uint32_t i = 0; i < toUpdateJS.Length(); i++) {
             auto pubkeyHex = toCppString(toUpdateJS[i], "membersMarkPendingRemoval");
-            auto existing = this->meta_group->members->get(pubkeyHex);
+            auto existing = this->meta_group()->members->get(pubkeyHex);
             if (existing) {
                 existing->set_removed(withMessages);
-                this->meta_group->members->set(*existing);
+                set_member(*existing);
             }
         }
     });
@@ -757,11 +1204,13 @@ Napi::Value MetaGroupWrapper::memberEraseAndRekey(const Napi::CallbackInfo& info
         auto rekeyed = false;
         for (uint32_t i = 0; i < toRemoveJS.Length(); i++) {
             auto pubkeyHex = toCppString(toRemoveJS[i], "memberEraseAndRekey");
-            rekeyed |= this->meta_group->members->erase(pubkeyHex);
+            mutated();
+            member_statuses_changed();
+            rekeyed |= this->meta_group()->members->erase(pubkeyHex);
         }
 
         if (rekeyed) {
-            meta_group->keys->rekey(*(this->meta_group->info), *(this->meta_group->members));
+            meta_group()->keys->rekey(*(this->meta_group()->info), *(this->meta_group()->members));
         }
 
         return rekeyed;
@@ -772,21 +1221,21 @@ Napi::Value MetaGroupWrapper::memberEraseAndRekey(const Napi::CallbackInfo& info
 
 /* #region KEYS ACTIONS */
 Napi::Value MetaGroupWrapper::keysNeedsRekey(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return meta_group->keys->needs_rekey(); });
+    return wrapResult(info, [&] { return meta_group()->keys->needs_rekey(); });
 }
 
 Napi::Value MetaGroupWrapper::keyRekey(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
-        return meta_group->keys->rekey(*(meta_group->info), *(meta_group->members));
+        return meta_group()->keys->rekey(*(meta_group()->info), *(meta_group()->members));
     });
 }
 
 Napi::Value MetaGroupWrapper::keyGetAll(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return meta_group->keys->group_keys(); });
+    return wrapResult(info, [&] { return meta_group()->keys->group_keys(); });
 }
 
 Napi::Value MetaGroupWrapper::keyGetEncryptionKeyHex(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return to_hex(meta_group->keys->group_enc_key()); });
+    return wrapResult(info, [&] { return to_hex(meta_group()->keys->group_enc_key()); });
 }
 
 Napi::Value MetaGroupWrapper::loadKeyMessage(const Napi::CallbackInfo& info) {
@@ -800,23 +1249,35 @@ Napi::Value MetaGroupWrapper::loadKeyMessage(const Napi::CallbackInfo& info) {
         auto data = toCppBuffer(info[1], "loadKeyMessage");
         auto timestamp_ms = toCppInteger(info[2], "loadKeyMessage");
 
-        return meta_group->keys->load_key_message(
-                hash, data, timestamp_ms, *(this->meta_group->info), *(this->meta_group->members));
+        return meta_group()->keys->load_key_message(
+                hash,
+                data,
+                timestamp_ms,
+                *(this->meta_group()->info),
+                *(this->meta_group()->members));
     });
 }
 
 Napi::Value MetaGroupWrapper::keyGetCurrentGen(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
         assertInfoLength(info, 0);
-        return meta_group->keys->current_generation();
+        return meta_group()->keys->current_generation();
     });
 }
 
 Napi::Value MetaGroupWrapper::activeHashes(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
-        auto keysHashes = meta_group->keys->active_hashes();
-        auto infoHashes = meta_group->info->active_hashes();
-        auto memberHashes = meta_group->members->active_hashes();
+        if (auto* metadata = pending_metadata()) {
+            std::vector<std::string> merged = metadata->keys_hashes;
+            merged.insert(merged.end(), metadata->info_hashes.begin(), metadata->info_hashes.end());
+            merged.insert(
+                    merged.end(), metadata->members_hashes.begin(), metadata->members_hashes.end());
+            return merged;
+        }
+
+        auto keysHashes = meta_group()->keys->active_hashes();
+        auto infoHashes = meta_group()->info->active_hashes();
+        auto memberHashes = meta_group()->members->active_hashes();
         std::vector<std::string> merged;
         std::copy(std::begin(keysHashes), std::end(keysHashes), std::back_inserter(merged));
         std::copy(std::begin(infoHashes), std::end(infoHashes), std::back_inserter(merged));
@@ -840,9 +1301,16 @@ Napi::Value MetaGroupWrapper::activeHashesByConfig(const Napi::CallbackInfo& inf
         auto env = info.Env();
         auto obj = Napi::Object::New(env);
 
-        auto keysHashes = meta_group->keys->active_hashes();
-        auto infoHashes = meta_group->info->active_hashes();
-        auto memberHashes = meta_group->members->active_hashes();
+        if (auto* metadata = pending_metadata()) {
+            obj["groupKeys"s] = toJs(env, metadata->keys_hashes);
+            obj["groupInfo"s] = toJs(env, metadata->info_hashes);
+            obj["groupMember"s] = toJs(env, metadata->members_hashes);
+            return obj;
+        }
+
+        auto keysHashes = meta_group()->keys->active_hashes();
+        auto infoHashes = meta_group()->info->active_hashes();
+        auto memberHashes = meta_group()->members->active_hashes();
 
         obj["groupKeys"s] =
                 toJs(env, std::vector<std::string>{keysHashes.begin(), keysHashes.end()});
@@ -868,7 +1336,7 @@ Napi::Value MetaGroupWrapper::encryptMessages(const Napi::CallbackInfo& info) {
         for (uint32_t i = 0; i < plaintextsJS.Length(); i++) {
             auto plaintext = toCppBuffer(plaintextsJS[i], "encryptMessages");
 
-            encryptedMessages.push_back(this->meta_group->keys->encrypt_message(plaintext));
+            encryptedMessages.push_back(this->meta_group()->keys->encrypt_message(plaintext));
         }
         return encryptedMessages;
     });
@@ -880,7 +1348,7 @@ Napi::Value MetaGroupWrapper::decryptMessage(const Napi::CallbackInfo& info) {
         assertIsUInt8Array(info[0], "decryptMessage");
 
         auto ciphertext = toCppBuffer(info[0], "decryptMessage");
-        auto decrypted = this->meta_group->keys->decrypt_message(ciphertext);
+        auto decrypted = this->meta_group()->keys->decrypt_message(ciphertext);
 
         return decrypt_result_to_JS(info.Env(), decrypted);
     });
@@ -893,7 +1361,7 @@ Napi::Value MetaGroupWrapper::makeSwarmSubAccount(const Napi::CallbackInfo& info
 
         auto memberPk = toCppString(info[0], "makeSwarmSubAccount");
         std::vector<unsigned char> subaccount =
-                this->meta_group->keys->swarm_make_subaccount(memberPk);
+                this->meta_group()->keys->swarm_make_subaccount(memberPk);
 
         session::nodeapi::checkOrThrow(
                 subaccount.size() == 100, "expected subaccount to be 100 bytes long");
@@ -909,7 +1377,7 @@ Napi::Value MetaGroupWrapper::swarmSubAccountToken(const Napi::CallbackInfo& inf
 
         auto memberPk = toCppString(info[0], "swarmSubAccountToken");
         std::vector<unsigned char> subaccount =
-                this->meta_group->keys->swarm_subaccount_token(memberPk);
+                this->meta_group()->keys->swarm_subaccount_token(memberPk);
 
         session::nodeapi::checkOrThrow(
                 subaccount.size() == 36, "expected subaccount token to be 36 bytes long");
@@ -924,7 +1392,7 @@ Napi::Value MetaGroupWrapper::swarmVerifySubAccount(const Napi::CallbackInfo& in
         assertIsUInt8Array(info[0], "swarmVerifySubAccount");
 
         auto signingValue = toCppBuffer(info[0], "swarmVerifySubAccount");
-        return this->meta_group->keys->swarm_verify_subaccount(signingValue);
+        return this->meta_group()->keys->swarm_verify_subaccount(signingValue);
     });
 }
 
@@ -934,8 +1402,8 @@ Napi::Value MetaGroupWrapper::loadAdminKeys(const Napi::CallbackInfo& info) {
         assertIsUInt8Array(info[0], "loadAdminKeys");
 
         auto secret = toCppBuffer(info[0], "loadAdminKeys");
-        this->meta_group->keys->load_admin_key(
-                secret, *(this->meta_group->info), *(this->meta_group->members));
+        this->meta_group()->keys->load_admin_key(
+                secret, *(this->meta_group()->info), *(this->meta_group()->members));
         return info.Env().Null();
     });
 }
@@ -943,7 +1411,7 @@ Napi::Value MetaGroupWrapper::loadAdminKeys(const Napi::CallbackInfo& info) {
 Napi::Value MetaGroupWrapper::keysAdmin(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
         assertInfoLength(info, 0);
-        return this->meta_group->keys->admin();
+        return this->meta_group()->keys->admin();
     });
 }
 
@@ -964,7 +1432,7 @@ Napi::Value MetaGroupWrapper::generateSupplementKeys(const Napi::CallbackInfo& i
             auto memberPk = toCppString(membersJS[i], "generateSupplementKeys");
             membersCpp.push_back(memberPk);
         }
-        return this->meta_group->keys->key_supplement(membersCpp);
+        return this->meta_group()->keys->key_supplement(membersCpp);
     });
 }
 
@@ -976,7 +1444,7 @@ Napi::Value MetaGroupWrapper::swarmSubaccountSign(const Napi::CallbackInfo& info
 
         auto message = toCppBuffer(info[0], "swarmSubaccountSign message");
         auto authdata = toCppBuffer(info[1], "swarmSubaccountSign authdata");
-        auto subaccountSign = this->meta_group->keys->swarm_subaccount_sign(message, authdata);
+        auto subaccountSign = this->meta_group()->keys->swarm_subaccount_sign(message, authdata);
 
         return subaccountSign;
     });
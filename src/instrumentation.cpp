@@ -0,0 +1,217 @@
+#include "instrumentation.hpp"
+
+#include <napi.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "meta/meta_base_wrapper.hpp"
+#include "utilities.hpp"
+
+namespace session::nodeapi::instrumentation {
+
+static size_t bucket_index(uint64_t ns) {
+    using H = LatencyHistogram;
+    if (ns < H::SUB_BUCKETS)
+        return ns;
+    int shift = std::bit_width(ns) - 1 - H::SUB_BUCKET_BITS;
+    return H::SUB_BUCKETS * (shift + 1) + ((ns >> shift) & (H::SUB_BUCKETS - 1));
+}
+
+// The middle of the range of values that land in bucket `index`.
+static uint64_t bucket_value(size_t index) {
+    using H = LatencyHistogram;
+    if (index < H::SUB_BUCKETS)
+        return index;
+    int shift = static_cast<int>(index / H::SUB_BUCKETS) - 1;
+    uint64_t lower = (H::SUB_BUCKETS + index % H::SUB_BUCKETS) << shift;
+    return lower + ((uint64_t{1} << shift) >> 1);
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+    counts_[bucket_index(ns)]++;
+    total_++;
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    if (!total_)
+        return 0;
+    auto target = std::max<uint64_t>(
+            1, static_cast<uint64_t>(std::ceil(std::clamp(p, 0.0, 1.0) * total_)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; i++) {
+        seen += counts_[i];
+        if (seen >= target)
+            return bucket_value(i);
+    }
+    UNREACHABLE();
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < BUCKETS; i++)
+        counts_[i] += other.counts_[i];
+    total_ += other.total_;
+}
+
+namespace {
+    // The std::source_location function name pointer and the ClassScope class name pointer of the
+    // recorded calls: cheap to look up on every call.
+    using stats_key = std::pair<const char*, const char*>;
+
+    struct stats_key_hash {
+        size_t operator()(const stats_key& key) const {
+            return std::hash<const char*>{}(key.first) * 31 + std::hash<const char*>{}(key.second);
+        }
+    };
+
+    // The same function can show up under several pointers (e.g. an inline function emitted in
+    // several translation units); getStats() merges those back by name.
+    std::mutex stats_mutex;
+    std::unordered_map<stats_key, MethodStats, stats_key_hash> stats;
+}  // namespace
+
+void record(
+        const char* function_name,
+        const char* class_name,
+        uint64_t ns,
+        bool error,
+        uint64_t bytes_in,
+        uint64_t bytes_out) {
+    std::lock_guard lock{stats_mutex};
+    auto& s = stats[{function_name, class_name}];
+    s.calls++;
+    if (error)
+        s.errors++;
+    s.total_ns += ns;
+    s.max_ns = std::max(s.max_ns, ns);
+    s.bytes_in += bytes_in;
+    s.bytes_out += bytes_out;
+    s.latency.record(ns);
+}
+
+// Turns a compiler-specific function signature such as
+// "Napi::Value session::nodeapi::MetaGroupWrapper::metaMerge(const Napi::CallbackInfo&)" into
+// "MetaGroupWrapper::metaMerge".
+static std::string method_name(std::string_view fn) {
+    fn = fn.substr(0, fn.find('('));
+
+    // Drop the return type (and MSVC's calling convention), minding spaces within template
+    // arguments.
+    size_t start = fn.size();
+    for (int angle = 0; start > 0; start--) {
+        char c = fn[start - 1];
+        if (c == '>')
+            angle++;
+        else if (c == '<')
+            angle--;
+        else if (c == ' ' && angle == 0)
+            break;
+    }
+    fn.remove_prefix(start);
+
+    constexpr auto ns_prefix = "session::nodeapi::"sv;
+    if (fn.starts_with(ns_prefix))
+        fn.remove_prefix(ns_prefix.size());
+    return std::string{fn};
+}
+
+// The name getStats() reports the calls of `function_name` under: its method_name(), with the class
+// replaced by `class_name` if set (see ClassScope).
+static std::string stats_name(const char* function_name, const char* class_name) {
+    auto name = method_name(function_name);
+    if (!class_name)
+        return name;
+    // The last scope separator before any template arguments.
+    auto sep = name.rfind("::", name.find('<'));
+    if (sep == std::string::npos)
+        return std::string{class_name} + "::" + name;
+    return class_name + name.substr(sep);
+}
+
+static double to_ms(uint64_t ns) {
+    return ns / 1e6;
+}
+
+void InstrumentationWrapper::Init(Napi::Env env, Napi::Object exports) {
+    MetaBaseWrapper::NoBaseClassInitHelper<InstrumentationWrapper>(
+            env,
+            exports,
+            "InstrumentationWrapperNode",
+            {
+                    StaticMethod<&InstrumentationWrapper::setEnabled>(
+                            "setEnabled",
+                            static_cast<napi_property_attributes>(
+                                    napi_writable | napi_configurable)),
+                    StaticMethod<&InstrumentationWrapper::getStats>(
+                            "getStats",
+                            static_cast<napi_property_attributes>(
+                                    napi_writable | napi_configurable)),
+                    StaticMethod<&InstrumentationWrapper::resetStats>(
+                            "resetStats",
+                            static_cast<napi_property_attributes>(
+                                    napi_writable | napi_configurable)),
+            });
+}
+
+void InstrumentationWrapper::setEnabled(const Napi::CallbackInfo& info) {
+    wrapExceptions(info, [&] {
+        assertInfoLength(info, 1);
+        enabled.store(toCppBoolean(info[0], "setEnabled"), std::memory_order_relaxed);
+    });
+}
+
+Napi::Value InstrumentationWrapper::getStats(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 0);
+
+        std::map<std::string, MethodStats> by_name;
+        {
+            std::lock_guard lock{stats_mutex};
+            for (const auto& [key, s] : stats) {
+                auto& merged = by_name[stats_name(key.first, key.second)];
+                merged.calls += s.calls;
+                merged.errors += s.errors;
+                merged.total_ns += s.total_ns;
+                merged.max_ns = std::max(merged.max_ns, s.max_ns);
+                merged.bytes_in += s.bytes_in;
+                merged.bytes_out += s.bytes_out;
+                merged.latency.merge(s.latency);
+            }
+        }
+
+        auto env = info.Env();
+        auto obj = Napi::Object::New(env);
+        for (const auto& [name, s] : by_name) {
+            auto entry = Napi::Object::New(env);
+            entry["calls"] = toJs(env, s.calls);
+            entry["errors"] = toJs(env, s.errors);
+            entry["totalMs"] = toJs(env, to_ms(s.total_ns));
+            entry["meanMs"] = toJs(env, to_ms(s.total_ns) / s.calls);
+            entry["p50Ms"] = toJs(env, to_ms(s.latency.percentile(0.5)));
+            entry["p99Ms"] = toJs(env, to_ms(s.latency.percentile(0.99)));
+            entry["maxMs"] = toJs(env, to_ms(s.max_ns));
+            entry["bytesIn"] = toJs(env, s.bytes_in);
+            entry["bytesOut"] = toJs(env, s.bytes_out);
+            obj[name] = entry;
+        }
+        return obj;
+    });
+}
+
+void InstrumentationWrapper::resetStats(const Napi::CallbackInfo& info) {
+    wrapExceptions(info, [&] {
+        assertInfoLength(info, 0);
+        std::lock_guard lock{stats_mutex};
+        stats.clear();
+    });
+}
+
+}  // namespace session::nodeapi::instrumentation
@@ -0,0 +1,128 @@
+#include "logger.hpp"
+
+#include <napi.h>
+
+#include <mutex>
+#include <oxen/log.hpp>
+#include <session/logging.hpp>
+
+#include "utilities.hpp"
+
+namespace session::nodeapi {
+
+namespace {
+    Napi::ThreadSafeFunction tsfn;
+    // Guards `tsfn` against the race between libsession's background log
+    // threads (which read it to schedule a flush through it) and N-API env
+    // teardown (which Releases and nulls it). The check + call when
+    // scheduling and the check + release in the cleanup hook must each be
+    // atomic w.r.t. the other, or we risk a torn read / use-after-free on
+    // the wrapper.  Producers only take it when they schedule a flush, i.e.
+    // once per batch rather than once per line.
+    std::mutex tsfn_mutex;
+
+    LogRing ring;
+
+    // Set while a flush is queued on the JS thread and hasn't started draining yet: any line
+    // pushed meanwhile is picked up by that flush, so there is no need to queue another.
+    std::atomic<bool> flush_scheduled{false};
+
+    // Upper bound on the lines written per flush, so that a producer logging non-stop cannot keep
+    // the JS thread draining forever; anything left over gets its own flush.
+    constexpr size_t MAX_LINES_PER_FLUSH = LogRing::CAPACITY;
+
+    void flush_to_console(Napi::Env env, Napi::Function) {
+        // Clear the flag *before* draining: a line pushed after this point either gets drained
+        // below or sees the flag cleared and schedules the next flush, so none are left behind.
+        flush_scheduled.store(false);
+
+        std::string batch, line;
+        size_t count = 0;
+        while (count < MAX_LINES_PER_FLUSH && ring.try_pop(line)) {
+            batch += "libsession: ";
+            batch += line;
+            batch += '\n';
+            count++;
+        }
+        if (auto dropped = ring.take_dropped())
+            batch += "libsession: " + std::to_string(dropped) +
+                     " log line(s) dropped: log buffer full\n";
+        if (batch.empty())
+            return;
+        batch.pop_back();
+
+        Napi::HandleScope scope(env);
+        Napi::Function consoleLog =
+                env.Global().Get("console").As<Napi::Object>().Get("log").As<Napi::Function>();
+        consoleLog.Call({Napi::String::New(env, batch)});
+    }
+
+    void schedule_flush() {
+        if (flush_scheduled.exchange(true))
+            return;
+
+        std::lock_guard<std::mutex> lock(tsfn_mutex);
+        // A rejected call (no tsfn anymore, or napi_closing if a Release slipped in) never runs
+        // the callback: clear the flag so that a later line retries.
+        if (!tsfn || tsfn.NonBlockingCall(flush_to_console) != napi_ok)
+            flush_scheduled.store(false);
+    }
+}  // namespace
+
+void initLogBridge(Napi::Env env) {
+    {
+        std::lock_guard<std::mutex> lock(tsfn_mutex);
+        tsfn = Napi::ThreadSafeFunction::New(
+                env,
+                Napi::Function::New(env, [](const Napi::CallbackInfo& info) {}),
+                "LoggerCallback",
+                0,
+                1);
+        // The logger callback is fire-and-forget. Without Unref(), the
+        // TSFN keeps a strong ref on the loop and a `require()` from a
+        // short-lived CLI hangs forever waiting on the TSFN.
+        tsfn.Unref(env);
+    }
+
+    // Release the TSFN when the N-API env tears down. Without this, a
+    // later libsession log from a background thread could call
+    // into a destroyed env (abort / UAF). Taking the lock makes the
+    // check + release atomic w.r.t. schedule_flush() above.
+    env.AddCleanupHook([]() {
+        std::lock_guard<std::mutex> lock(tsfn_mutex);
+        if (tsfn) {
+            tsfn.Release();
+            tsfn = nullptr;
+        }
+    });
+
+    // Register the libsession -> console.log bridge exactly once per
+    // process. Re-running InitAll (multiple Workers / vm contexts) must
+    // not stack duplicate callbacks onto libsession's global logger
+    // registry — the single persistent callback always flushes through
+    // whatever the current `tsfn` is, under the lock.
+    static std::once_flag logger_once;
+    std::call_once(logger_once, [] {
+        session::add_logger([](std::string_view msg) {
+            // Even on a drop: the flush reports the drop count.
+            ring.try_push(std::string{msg});
+            schedule_flush();
+        });
+    });
+}
+
+void LoggerWrapper::setLogLevel(const Napi::CallbackInfo& info) {
+    wrapExceptions(info, [&] {
+        assertInfoLength(info, 2);
+        auto category = maybeNonemptyString(info[0], "setLogLevel.category");
+        assertIsString(info[1], "setLogLevel.level");
+        auto level = oxen::log::level_from_string(toCppString(info[1], "setLogLevel.level"));
+
+        if (category)
+            oxen::log::set_level(*category, level);
+        else
+            oxen::log::set_level_default(level);
+    });
+}
+
+}  // namespace session::nodeapi
@@ -1,91 +1,152 @@
 #include "meta/meta_base_wrapper.hpp"
 
 #include <napi.h>
+#include <oxenc/bt_serialize.h>
 
 #include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "bt_writer.hpp"
 #include "groups/meta_group.hpp"
 
 namespace session::nodeapi {
 
-std::unique_ptr<session::nodeapi::MetaGroup> MetaBaseWrapper::constructGroupWrapper(
-        const Napi::CallbackInfo& info, const std::string& class_name) {
-    return wrapExceptions(info, [&] {
-        if (!info.IsConstructCall())
-            throw std::invalid_argument{"You need to call the constructor with the `new` syntax"};
-
-        assertInfoLength(info, 1);
-        auto arg = info[0];
-        assertIsObject(arg);
-        auto obj = arg.As<Napi::Object>();
-
-        if (obj.IsEmpty())
-            throw std::invalid_argument("constructGroupWrapper received empty");
-
-        assertIsUInt8Array(obj.Get("userEd25519Secretkey"), "constructGroupWrapper userEd");
-        auto user_ed25519_secretkey = toCppBuffer(
-                obj.Get("userEd25519Secretkey"),
-                class_name + ":constructGroupWrapper.userEd25519Secretkey");
-
-        assertIsUInt8Array(obj.Get("groupEd25519Pubkey"), "constructGroupWrapper groupEd");
-        auto group_ed25519_pubkey = toCppBuffer(
-                obj.Get("groupEd25519Pubkey"),
-                class_name + ":constructGroupWrapper.groupEd25519Pubkey");
-
-        std::optional<std::vector<unsigned char>> group_ed25519_secretkey = maybeNonemptyBuffer(
-                obj.Get("groupEd25519Secretkey"),
-                class_name + ":constructGroupWrapper.groupEd25519Secretkey");
-
-        std::optional<std::vector<unsigned char>> dumped_meta = maybeNonemptyBuffer(
-                obj.Get("metaDumped"), class_name + ":constructGroupWrapper.metaDumped");
-
-        std::optional<std::string> dumped_info;
-        std::optional<std::string> dumped_members;
-        std::optional<std::string> dumped_keys;
-
-        if (dumped_meta) {
-            auto dumped_meta_str = to_string(*dumped_meta);
-
-            oxenc::bt_dict_consumer combined{dumped_meta_str};
-            // NB: must read in ascii-sorted order:
-            if (!combined.skip_until("info"))
-                throw std::runtime_error{"info dump not found in combined dump!"};
-            dumped_info = combined.consume_string();
-
-            if (!combined.skip_until("keys"))
-                throw std::runtime_error{"keys dump not found in combined dump!"};
-            dumped_keys = combined.consume_string();
-
-            if (!combined.skip_until("members"))
-                throw std::runtime_error{"members dump not found in combined dump!"};
-            dumped_members = combined.consume_string();
-        }
-
-        // Note, we keep shared_ptr for those as the Keys one need a reference to Members and
-        // Info on its own currently.
-        auto info = std::make_shared<config::groups::Info>(
-                group_ed25519_pubkey,
-                group_ed25519_secretkey,
-                (dumped_info ? std::make_optional(session::to_span(*dumped_info)) : std::nullopt));
-
-        auto members = std::make_shared<config::groups::Members>(
-                group_ed25519_pubkey,
-                group_ed25519_secretkey,
-                (dumped_members ? std::make_optional(session::to_span(*dumped_members))
-                                : std::nullopt));
-
-        auto keys = std::make_shared<config::groups::Keys>(
-                user_ed25519_secretkey,
-                group_ed25519_pubkey,
-                group_ed25519_secretkey,
-                (dumped_keys ? std::make_optional(session::to_span(*dumped_keys)) : std::nullopt),
-                *info,
-                *members);
-
-        return std::make_unique<session::nodeapi::MetaGroup>(
-                info, members, keys, group_ed25519_pubkey, group_ed25519_secretkey);
-    });
+group_wrapper_args MetaBaseWrapper::parseGroupWrapperArgs(
+        const Napi::Value& arg, const std::string& class_name) {
+    assertIsObject(arg);
+    auto obj = arg.As<Napi::Object>();
+
+    if (obj.IsEmpty())
+        throw std::invalid_argument("constructGroupWrapper received empty");
+
+    group_wrapper_args args;
+    assertIsUInt8Array(obj.Get("userEd25519Secretkey"), "constructGroupWrapper userEd");
+    args.user_ed25519_secretkey = toCppBuffer(
+            obj.Get("userEd25519Secretkey"),
+            class_name + ":constructGroupWrapper.userEd25519Secretkey");
+
+    assertIsUInt8Array(obj.Get("groupEd25519Pubkey"), "constructGroupWrapper groupEd");
+    args.group_ed25519_pubkey = toCppBuffer(
+            obj.Get("groupEd25519Pubkey"),
+            class_name + ":constructGroupWrapper.groupEd25519Pubkey");
+
+    args.group_ed25519_secretkey = maybeNonemptyBuffer(
+            obj.Get("groupEd25519Secretkey"),
+            class_name + ":constructGroupWrapper.groupEd25519Secretkey");
+
+    args.dumped_meta = maybeNonemptyBuffer(
+            obj.Get("metaDumped"), class_name + ":constructGroupWrapper.metaDumped");
+    return args;
+}
+
+// Reads the list of strings `key` of `dict`, if there.
+static std::vector<std::string> consume_string_list(
+        oxenc::bt_dict_consumer& dict, std::string_view key) {
+    std::vector<std::string> strings;
+    if (dict.skip_until(key)) {
+        auto list = dict.consume_list_consumer();
+        while (!list.is_finished())
+            strings.push_back(list.consume_string());
+    }
+    return strings;
+}
+
+group_dump MetaBaseWrapper::splitGroupDump(std::span<const unsigned char> dumped_meta) {
+    group_dump dump;
+    oxenc::bt_dict_consumer combined{as_string_view(dumped_meta)};
+    // NB: must read in ascii-sorted order:
+    if (combined.skip_until("cache")) {
+        auto cache = combined.consume_dict_consumer();
+        auto& metadata = dump.metadata.emplace();
+        metadata.info_hashes = consume_string_list(cache, "infoHashes");
+        metadata.keys_hashes = consume_string_list(cache, "keysHashes");
+        metadata.members_hashes = consume_string_list(cache, "membersHashes");
+        metadata.needs_push = cache.skip_until("needsPush") && cache.consume_integer<int>() != 0;
+    }
+
+    if (!combined.skip_until("info"))
+        throw std::runtime_error{"info dump not found in combined dump!"};
+    dump.info = as_span(combined.consume_string_view());
+
+    if (!combined.skip_until("keys"))
+        throw std::runtime_error{"keys dump not found in combined dump!"};
+    dump.keys = as_span(combined.consume_string_view());
+
+    if (!combined.skip_until("members"))
+        throw std::runtime_error{"members dump not found in combined dump!"};
+    dump.members = as_span(combined.consume_string_view());
+    return dump;
+}
+
+// NOTE: the keys have to be in ascii-sorted order.  Older versions skip "cache", as they look up
+// the others by name.
+static void write_group_dump(bt_writer& out, const group_dump& dump) {
+    out.raw('d');
+    if (dump.metadata) {
+        out.string("cache");
+        out.raw('d');
+        out.string("infoHashes");
+        out.list(dump.metadata->info_hashes);
+        out.string("keysHashes");
+        out.list(dump.metadata->keys_hashes);
+        out.string("membersHashes");
+        out.list(dump.metadata->members_hashes);
+        out.string("needsPush");
+        out.integer(dump.metadata->needs_push ? 1 : 0);
+        out.raw('e');
+    }
+    out.string("info");
+    out.string(dump.info);
+    out.string("keys");
+    out.string(dump.keys);
+    out.string("members");
+    out.string(dump.members);
+    out.raw('e');
+}
+
+std::vector<unsigned char> MetaBaseWrapper::combineGroupDump(const group_dump& dump) {
+    return write_bt([&](bt_writer& out) { write_group_dump(out, dump); });
+}
+
+std::unique_ptr<session::nodeapi::MetaGroup> MetaBaseWrapper::loadMetaGroup(
+        const group_wrapper_args& args) {
+    std::optional<group_dump> dump;
+    if (args.dumped_meta)
+        dump = splitGroupDump(*args.dumped_meta);
+    return loadMetaGroup(args, dump ? &*dump : nullptr);
+}
+
+std::unique_ptr<session::nodeapi::MetaGroup> MetaBaseWrapper::loadMetaGroup(
+        const group_wrapper_args& args, const group_dump* dump) {
+    // The dumps are passed to libsession as views into the combined dump, uncopied.
+    using config_dump = std::optional<std::span<const unsigned char>>;
+    auto dumped = [dump](std::span<const unsigned char> group_dump::*config) -> config_dump {
+        return dump ? config_dump{dump->*config} : std::nullopt;
+    };
+
+    // Note, we keep shared_ptr for those as the Keys one need a reference to Members and
+    // Info on its own currently.
+    auto info = std::make_shared<config::groups::Info>(
+            args.group_ed25519_pubkey, args.group_ed25519_secretkey, dumped(&group_dump::info));
+
+    auto members = std::make_shared<config::groups::Members>(
+            args.group_ed25519_pubkey,
+            args.group_ed25519_secretkey,
+            dumped(&group_dump::members));
+
+    auto keys = std::make_shared<config::groups::Keys>(
+            args.user_ed25519_secretkey,
+            args.group_ed25519_pubkey,
+            args.group_ed25519_secretkey,
+            dumped(&group_dump::keys),
+            *info,
+            *members);
+
+    return std::make_unique<session::nodeapi::MetaGroup>(
+            info, members, keys, args.group_ed25519_pubkey, args.group_ed25519_secretkey);
 }
 
 }  // namespace session::nodeapi
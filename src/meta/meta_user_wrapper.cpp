@@ -0,0 +1,291 @@
+#include "meta/meta_user_wrapper.hpp"
+
+#include <napi.h>
+#include <oxenc/bt_serialize.h>
+
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "addon_data.hpp"
+#include "async_worker.hpp"
+#include "bt_writer.hpp"
+#include "contacts_config.hpp"
+#include "convo_info_volatile_config.hpp"
+#include "meta/meta_base_wrapper.hpp"
+#include "object_shape.hpp"
+#include "parallel.hpp"
+#include "session/config/contacts.hpp"
+#include "session/config/convo_info_volatile.hpp"
+#include "session/config/user_groups.hpp"
+#include "session/config/user_profile.hpp"
+#include "user_config.hpp"
+#include "user_groups_config.hpp"
+
+namespace session::nodeapi {
+
+// The keys of the configs in the combined dump and in the objects taken and returned by the
+// combined methods.  NB: in ascii-sorted order, as the combined dump requires.
+static constexpr std::array<const char*, 4> USER_CONFIG_NAMES{
+        "contacts", "convoInfoVolatile", "userGroups", "userProfile"};
+
+// An object with one property per config, in the order of USER_CONFIG_NAMES.
+static Napi::Object by_config(const Napi::Env& env, const std::array<napi_value, 4>& values) {
+    return define_object(env, interned_keys(env, USER_CONFIG_NAMES), values);
+}
+
+// The dumps of the configs, as views into a combined dump.
+using config_dumps = std::array<std::optional<std::span<const unsigned char>>, 4>;
+
+// Splits a combined dump (see metaDump()) into the dumps of the configs, without copying them; a
+// config missing from it (e.g. one added after the dump was made) gets none, and so starts empty.
+static config_dumps split_meta_dump(std::span<const unsigned char> dumped) {
+    config_dumps dumps;
+    oxenc::bt_dict_consumer combined{as_string_view(dumped)};
+    for (size_t i = 0; i < USER_CONFIG_NAMES.size(); i++)
+        if (combined.skip_until(USER_CONFIG_NAMES[i]))
+            dumps[i] = as_span(combined.consume_string_view());
+    return dumps;
+}
+
+// The inverse of split_meta_dump(), written in a single allocation.
+static std::vector<unsigned char> combine_meta_dump(
+        const std::array<std::vector<unsigned char>, 4>& dumps) {
+    return write_bt([&](bt_writer& out) {
+        out.raw('d');
+        for (size_t i = 0; i < dumps.size(); i++) {
+            out.string(USER_CONFIG_NAMES[i]);
+            out.string(dumps[i]);
+        }
+        out.raw('e');
+    });
+}
+
+void MetaUserWrapper::Init(Napi::Env env, Napi::Object exports) {
+    MetaBaseWrapper::NoBaseClassInitHelper<MetaUserWrapper>(
+            env,
+            exports,
+            "MetaUserWrapperNode",
+            {
+                    StaticMethod<&MetaUserWrapper::createAsync>("createAsync"),
+                    InstanceMethod("configs", &MetaUserWrapper::configs),
+                    InstanceMethod("needsPush", &MetaUserWrapper::needsPush),
+                    InstanceMethod("push", &MetaUserWrapper::push),
+                    InstanceMethod("needsDump", &MetaUserWrapper::needsDump),
+                    InstanceMethod("metaDump", &MetaUserWrapper::metaDump),
+                    InstanceMethod("metaMakeDump", &MetaUserWrapper::metaMakeDump),
+                    InstanceMethod("metaConfirmPushed", &MetaUserWrapper::metaConfirmPushed),
+                    InstanceMethod("metaMerge", &MetaUserWrapper::metaMerge),
+            });
+}
+
+template <typename Wrapper>
+MetaUserWrapper::user_config MetaUserWrapper::adopt(
+        Napi::Env env, const char* class_name, std::shared_ptr<config::ConfigBase> conf) {
+    auto obj = adopt_config(AddonData::get(env).constructor(class_name), std::move(conf));
+    return {Napi::Persistent(obj), Wrapper::Unwrap(obj)};
+}
+
+MetaUserWrapper::loaded_configs MetaUserWrapper::load(const config_args& args) {
+    // The configs load their dumps straight from the combined dump, uncopied.
+    config_dumps dumps;
+    if (args.dump)
+        dumps = split_meta_dump(*args.dump);
+
+    loaded_configs confs;
+    auto construct_one = [&](size_t i) {
+        const auto& dump = dumps[i];
+        const auto& key = args.secret_key;
+        switch (i) {
+            case 0: confs[i] = std::make_shared<config::Contacts>(key, dump); break;
+            case 1: confs[i] = std::make_shared<config::ConvoInfoVolatile>(key, dump); break;
+            case 2: confs[i] = std::make_shared<config::UserGroups>(key, dump); break;
+            case 3: confs[i] = std::make_shared<config::UserProfile>(key, dump); break;
+        }
+    };
+    // The configs are independent, and loading a large one is far more work than the usual
+    // parallel_for item: when there are dumps to load, each can go to its own thread.
+    parallel_for(confs.size(), construct_one, args.dump ? 1 : PARALLEL_MIN_ITEMS);
+    return confs;
+}
+
+MetaUserWrapper::MetaUserWrapper(const Napi::CallbackInfo& info) :
+        Napi::ObjectWrap<MetaUserWrapper>{info} {
+    wrapExceptions(info, [&] {
+        if (!info.IsConstructCall())
+            throw std::invalid_argument{"You need to call the constructor with the `new` syntax"};
+
+        // the configs loaded by createAsync()
+        loaded_configs confs;
+        if (auto* loaded = adopted<loaded_configs>(info))
+            confs = std::move(*loaded);
+        else
+            confs = load(config_args_from_JS(info, "MetaUserWrapper.new"));
+
+        auto env = info.Env();
+        configs_[0] = adopt<ContactsConfigWrapper>(env, "ContactsConfigWrapperNode", confs[0]);
+        configs_[1] =
+                adopt<ConvoInfoVolatileWrapper>(env, "ConvoInfoVolatileWrapperNode", confs[1]);
+        configs_[2] = adopt<UserGroupsWrapper>(env, "UserGroupsWrapperNode", confs[2]);
+        configs_[3] = adopt<UserConfigWrapper>(env, "UserConfigWrapperNode", confs[3]);
+    });
+}
+
+Napi::Value MetaUserWrapper::createAsync(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        auto args = config_args_from_JS(info, "MetaUserWrapper.createAsync");
+        auto cls = called_class(info);
+
+        auto* worker = makePromiseWorker(
+                info.Env(),
+                "MetaUserWrapper::createAsync",
+                [args = std::move(args)] { return load(args); },
+                [cls = Napi::Persistent(cls)](const Napi::Env&, loaded_configs confs) {
+                    return construct_adopting(cls.Value(), std::move(confs));
+                });
+        return worker->QueuePromise();
+    });
+}
+
+std::array<config::ConfigBase*, 4> MetaUserWrapper::all_configs() {
+    std::array<config::ConfigBase*, 4> confs;
+    for (size_t i = 0; i < configs_.size(); i++)
+        confs[i] = &configs_[i].config();
+    return confs;
+}
+
+Napi::Value MetaUserWrapper::configs(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 0);
+        std::array<napi_value, 4> objects;
+        for (size_t i = 0; i < configs_.size(); i++)
+            objects[i] = configs_[i].object.Value();
+        return by_config(info.Env(), objects);
+    });
+}
+
+Napi::Value MetaUserWrapper::needsPush(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 0);
+        bool needs_push = false;
+        for (auto* conf : all_configs())
+            needs_push |= conf->needs_push();
+        return needs_push;
+    });
+}
+
+Napi::Value MetaUserWrapper::push(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 0);
+        auto env = info.Env();
+        auto confs = all_configs();
+        std::array<napi_value, 4> to_push;
+        for (size_t i = 0; i < confs.size(); i++) {
+            auto& conf = *confs[i];
+            if (conf.needs_push()) {
+                configs_[i].mutated();
+                to_push[i] = push_result_to_JS(env, conf.push(), conf.storage_namespace());
+            } else {
+                to_push[i] = env.Null();
+            }
+        }
+        return by_config(env, to_push);
+    });
+}
+
+Napi::Value MetaUserWrapper::needsDump(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 0);
+        bool needs_dump = false;
+        for (auto* conf : all_configs())
+            needs_dump |= conf->needs_dump();
+        return needs_dump;
+    });
+}
+
+Napi::Value MetaUserWrapper::metaDump(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 0);
+        auto confs = all_configs();
+        std::array<std::vector<unsigned char>, 4> dumps;
+        for (size_t i = 0; i < confs.size(); i++)
+            dumps[i] = confs[i]->dump();
+        return combine_meta_dump(dumps);
+    });
+}
+
+Napi::Value MetaUserWrapper::metaMakeDump(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 0);
+        auto confs = all_configs();
+        std::array<std::vector<unsigned char>, 4> dumps;
+        for (size_t i = 0; i < confs.size(); i++)
+            dumps[i] = confs[i]->make_dump();
+        return combine_meta_dump(dumps);
+    });
+}
+
+void MetaUserWrapper::metaConfirmPushed(const Napi::CallbackInfo& info) {
+    wrapExceptions(info, [&] {
+        assertInfoLength(info, 1);
+        assertIsObject(info[0]);
+        auto obj = info[0].As<Napi::Object>();
+
+        // Everything is parsed, and every config checked, before anything is confirmed.
+        std::array<std::optional<confirm_pushed_entry_t>, 4> entries;
+        for (size_t i = 0; i < configs_.size(); i++) {
+            auto pushed = obj.Get(USER_CONFIG_NAMES[i]);
+            if (pushed.IsNull() || pushed.IsUndefined())
+                continue;
+            assertIsObject(pushed);
+            entries[i] = confirm_pushed_entry_from_JS(info.Env(), pushed.As<Napi::Object>());
+        }
+        auto confs = all_configs();
+
+        for (size_t i = 0; i < confs.size(); i++) {
+            if (!entries[i])
+                continue;
+            auto& [seqno, hashes] = *entries[i];
+            configs_[i].mutated();
+            confs[i]->confirm_pushed(seqno, hashes);
+        }
+    });
+}
+
+Napi::Value MetaUserWrapper::metaMerge(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        assertInfoLength(info, 1);
+        assertIsObject(info[0]);
+        auto obj = info[0].As<Napi::Object>();
+
+        // Everything is parsed, and every config checked, before anything is merged, so that
+        // invalid input (or a busy config) merges nothing.
+        std::array<merge_entries, 4> entries;
+        for (size_t i = 0; i < configs_.size(); i++) {
+            auto to_merge = obj.Get(USER_CONFIG_NAMES[i]);
+            if (!to_merge.IsNull() && !to_merge.IsUndefined())
+                entries[i] = merge_entries_from_JS(
+                        to_merge,
+                        std::string{"MetaUserWrapper::metaMerge "} + USER_CONFIG_NAMES[i],
+                        false);
+        }
+
+        auto confs = all_configs();
+
+        auto env = info.Env();
+        std::array<napi_value, 4> merged;
+        for (size_t i = 0; i < confs.size(); i++) {
+            std::vector<std::string> hashes;
+            if (!entries[i].empty()) {
+                configs_[i].mutated();
+                auto merged_hashes = confs[i]->merge(entries[i].configs);
+                hashes.assign(merged_hashes.begin(), merged_hashes.end());
+            }
+            merged[i] = toJs(env, hashes);
+        }
+        return by_config(env, merged);
+    });
+}
+
+}  // namespace session::nodeapi
@@ -0,0 +1,125 @@
+#include "parallel.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <vector>
+
+namespace session::nodeapi {
+
+// The helper threads of parallel_for(), shared by the whole process.
+class ParallelPool {
+  public:
+    static ParallelPool& get() {
+        // Never destroyed: the helpers can outlive the static destructors at exit.
+        static auto* pool = new ParallelPool{};
+        return *pool;
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard lock{mutex_};
+            tasks_.push_back(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+  private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> tasks_;
+
+    ParallelPool() {
+        // The caller of parallel_for is one of its threads: the helpers make up the rest.
+        unsigned helpers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+        for (unsigned i = 0; i < helpers; i++) {
+            try {
+                std::thread{[this] { run(); }}.detach();
+            } catch (const std::system_error&) {
+                // Couldn't start another thread: just carry on with the ones we have (if none,
+                // the callers of parallel_for do all the work).
+                break;
+            }
+        }
+    }
+
+    [[noreturn]] void run() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock{mutex_};
+                cv_.wait(lock, [this] { return !tasks_.empty(); });
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+};
+
+// One parallel_for() call, shared with the helper tasks it submitted.  These may only get to run
+// after the call is over (the helpers being busy with others): they then find it `closed` and
+// return without touching `fn`, which lives on the caller's stack.
+struct parallel_job {
+    size_t count;
+    const std::function<void(size_t)>* fn;
+    std::atomic<size_t> next{0};
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool closed = false;
+    unsigned active = 0;
+    std::exception_ptr error;
+
+    // Calls fn on the remaining indices, stopping them all on the first exception.
+    void work() {
+        try {
+            for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;)
+                (*fn)(i);
+        } catch (...) {
+            std::lock_guard lock{mutex};
+            if (!error)
+                error = std::current_exception();
+            next.store(count, std::memory_order_relaxed);
+        }
+    }
+
+    void help() {
+        {
+            std::lock_guard lock{mutex};
+            if (closed)
+                return;
+            active++;
+        }
+        work();
+        {
+            std::lock_guard lock{mutex};
+            active--;
+        }
+        cv.notify_all();
+    }
+};
+
+void parallel_for_impl(size_t count, unsigned nthreads, const std::function<void(size_t)>& fn) {
+    auto job = std::make_shared<parallel_job>();
+    job->count = count;
+    job->fn = &fn;
+
+    auto& pool = ParallelPool::get();
+    for (unsigned t = 1; t < nthreads; t++)
+        pool.submit([job] { job->help(); });
+
+    job->work();
+
+    std::unique_lock lock{job->mutex};
+    job->closed = true;
+    job->cv.wait(lock, [&] { return job->active == 0; });
+    if (job->error)
+        std::rethrow_exception(job->error);
+}
+
+}  // namespace session::nodeapi
@@ -70,6 +70,8 @@ void UserConfigWrapper::Init(Napi::Env env, Napi::Object exports) {
             exports,
             "UserConfigWrapperNode",
             {
+                    StaticMethod<&createAsync<UserConfigWrapper, config::UserProfile>>(
+                            "createAsync"),
                     InstanceMethod("getPriority", &UserConfigWrapper::getPriority),
                     InstanceMethod("getName", &UserConfigWrapper::getName),
                     InstanceMethod("getProfilePic", &UserConfigWrapper::getProfilePic),
@@ -114,27 +116,27 @@ void UserConfigWrapper::Init(Napi::Env env, Napi::Object exports) {
 }
 
 UserConfigWrapper::UserConfigWrapper(const Napi::CallbackInfo& info) :
-        ConfigBaseImpl{construct<config::UserProfile>(info, "UserConfig")},
+        ConfigBaseImpl{construct<config::UserProfile>(info, CLASS_NAME), CLASS_NAME},
         Napi::ObjectWrap<UserConfigWrapper>{info} {}
 
 Napi::Value UserConfigWrapper::getPriority(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
         auto env = info.Env();
-        return config.get_nts_priority();
+        return config().get_nts_priority();
     });
 }
 
 Napi::Value UserConfigWrapper::getName(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
         auto env = info.Env();
-        return config.get_name();
+        return config().get_name();
     });
 }
 
 Napi::Value UserConfigWrapper::getProfilePic(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
         auto env = info.Env();
-        auto pic = config.get_profile_pic();
+        auto pic = config().get_profile_pic();
         auto obj = Napi::Object::New(env);
         if (pic) {
             obj["url"] = toJs(env, pic.url);
@@ -154,8 +156,8 @@ void UserConfigWrapper::setPriority(const Napi::CallbackInfo& info) {
         auto priority = info[0];
         assertIsNumber(priority, "UserConfigWrapper::setPriority");
 
-        auto new_priority = toPriority(priority, config.get_nts_priority());
-        config.set_nts_priority(new_priority);
+        auto new_priority = toPriority(priority, config().get_nts_priority());
+        config().set_nts_priority(new_priority);
     });
 }
 
@@ -168,7 +170,7 @@ void UserConfigWrapper::setName(const Napi::CallbackInfo& info) {
 
         auto new_name = name.As<Napi::String>().Utf8Value();
         // this will throw if the name is too long
-        config.set_name(new_name);
+        config().set_name(new_name);
     });
 }
 
@@ -181,7 +183,7 @@ void UserConfigWrapper::setNameTruncated(const Napi::CallbackInfo& info) {
 
         auto new_name = name.As<Napi::String>().Utf8Value();
         // this will truncate silently if the name is too long
-        config.set_name_truncated(new_name);
+        config().set_name_truncated(new_name);
     });
 }
 
@@ -193,31 +195,33 @@ void UserConfigWrapper::setNewProfilePic(const Napi::CallbackInfo& info) {
         if (!profile_pic_obj.IsNull() && !profile_pic_obj.IsUndefined())
             assertIsObject(profile_pic_obj);
 
-        config.set_profile_pic(profile_pic_from_object(profile_pic_obj));
+        config().set_profile_pic(profile_pic_from_object(profile_pic_obj));
     });
 }
 
 void UserConfigWrapper::setReuploadProfilePic(const Napi::CallbackInfo& info) {
-    assertInfoLength(info, 1);
-    auto profile_pic_obj = info[0];
+    return wrapExceptions(info, [&] {
+        assertInfoLength(info, 1);
+        auto profile_pic_obj = info[0];
 
-    if (!profile_pic_obj.IsNull() && !profile_pic_obj.IsUndefined())
-        assertIsObject(profile_pic_obj);
+        if (!profile_pic_obj.IsNull() && !profile_pic_obj.IsUndefined())
+            assertIsObject(profile_pic_obj);
 
-    config.set_reupload_profile_pic(profile_pic_from_object(profile_pic_obj));
+        config().set_reupload_profile_pic(profile_pic_from_object(profile_pic_obj));
+    });
 }
 
 Napi::Value UserConfigWrapper::getProfileUpdatedSeconds(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
         auto env = info.Env();
-        return config.get_profile_updated();
+        return config().get_profile_updated();
     });
 }
 
 Napi::Value UserConfigWrapper::getEnableBlindedMsgRequest(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
         auto env = info.Env();
-        auto blindedMsgRequest = toJs(env, config.get_blinded_msgreqs());
+        auto blindedMsgRequest = toJs(env, config().get_blinded_msgreqs());
 
         return blindedMsgRequest;
     });
@@ -231,13 +235,13 @@ void UserConfigWrapper::setEnableBlindedMsgRequest(const Napi::CallbackInfo& inf
         assertIsBoolean(blindedMsgRequests);
 
         auto blindedMsgReqCpp = toCppBoolean(blindedMsgRequests, "set_blinded_msgreqs");
-        config.set_blinded_msgreqs(blindedMsgReqCpp);
+        config().set_blinded_msgreqs(blindedMsgReqCpp);
     });
 }
 
 Napi::Value UserConfigWrapper::getNoteToSelfExpiry(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
-        auto nts_expiry = config.get_nts_expiry();
+        auto nts_expiry = config().get_nts_expiry();
         if (nts_expiry) {
             return nts_expiry->count();
         }
@@ -254,14 +258,14 @@ void UserConfigWrapper::setNoteToSelfExpiry(const Napi::CallbackInfo& info) {
         assertIsNumber(expirySeconds, "setNoteToSelfExpiry");
 
         auto expiryCppSeconds = toCppInteger(expirySeconds, "set_nts_expiry", false);
-        config.set_nts_expiry(std::chrono::seconds{expiryCppSeconds});
+        config().set_nts_expiry(std::chrono::seconds{expiryCppSeconds});
     });
 }
 
 Napi::Value UserConfigWrapper::getProConfig(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
-        if (config.get_pro_config().has_value()) {
-            return toJs(info.Env(), config.get_pro_config().value());
+        if (config().get_pro_config().has_value()) {
+            return toJs(info.Env(), config().get_pro_config().value());
         }
 
         return info.Env().Null();
@@ -281,7 +285,7 @@ void UserConfigWrapper::setProConfig(const Napi::CallbackInfo& info) {
         session::config::ProConfig pro_config =
                 pro_config_from_object(pro_config_js.As<Napi::Object>());
 
-        config.set_pro_config(pro_config);
+        config().set_pro_config(pro_config);
     });
 }
 
@@ -289,19 +293,19 @@ Napi::Value UserConfigWrapper::removeProConfig(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
         assertInfoLength(info, 0);
 
-        return config.remove_pro_config();
+        return config().remove_pro_config();
     });
 }
 
 Napi::Value UserConfigWrapper::getProProfileBitset(const Napi::CallbackInfo& info) {
     return wrapResult(
-            info, [&] { return proProfileBitsetToJS(info.Env(), config.get_profile_bitset()); });
+            info, [&] { return proProfileBitsetToJS(info.Env(), config().get_profile_bitset()); });
 }
 
 Napi::Value UserConfigWrapper::getProAccessExpiry(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
         // libsession now stores this in whole seconds; the JS domain is milliseconds
-        auto expiry_s = config.get_pro_access_expiry();
+        auto expiry_s = config().get_pro_access_expiry();
         std::optional<std::chrono::sys_time<std::chrono::milliseconds>> expiry_ms;
         if (expiry_s)
             expiry_ms = std::chrono::sys_time<std::chrono::milliseconds>(
@@ -318,7 +322,7 @@ void UserConfigWrapper::setProBadge(const Napi::CallbackInfo& info) {
 
         auto enabled = toCppBoolean(info[0], "UserConfigWrapper::setProBadge");
 
-        config.set_pro_badge(enabled);
+        config().set_pro_badge(enabled);
     });
 }
 
@@ -329,7 +333,7 @@ void UserConfigWrapper::setAnimatedAvatar(const Napi::CallbackInfo& info) {
 
         auto enabled = toCppBoolean(info[0], "UserConfigWrapper::setAnimatedAvatar");
 
-        config.set_animated_avatar(enabled);
+        config().set_animated_avatar(enabled);
     });
 }
 
@@ -346,7 +350,7 @@ void UserConfigWrapper::setProAccessExpiry(const Napi::CallbackInfo& info) {
         if (proAccessExpiryMs)
             proAccessExpiry = std::chrono::floor<std::chrono::seconds>(*proAccessExpiryMs);
 
-        config.set_pro_access_expiry(proAccessExpiry);
+        config().set_pro_access_expiry(proAccessExpiry);
     });
 }
 
@@ -416,7 +420,7 @@ Napi::Value UserConfigWrapper::getRefundRequested(const Napi::CallbackInfo& info
     return wrapResult(info, [&] {
         // libsession stores whole seconds; the JS domain is milliseconds. Null when unset (or
         // gated).
-        auto refund_s = config.get_refund_requested();
+        auto refund_s = config().get_refund_requested();
         std::optional<std::chrono::sys_time<std::chrono::milliseconds>> refund_ms;
         if (refund_s)
             refund_ms = std::chrono::sys_time<std::chrono::milliseconds>(
@@ -434,13 +438,13 @@ void UserConfigWrapper::setRefundRequested(const Napi::CallbackInfo& info) {
         std::optional<std::chrono::sys_seconds> refund;
         if (refund_ms)
             refund = std::chrono::floor<std::chrono::seconds>(*refund_ms);
-        config.set_refund_requested(refund);
+        config().set_refund_requested(refund);
     });
 }
 
 Napi::Value UserConfigWrapper::getProPrepaid(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
-        auto prepaid_s = config.get_pro_prepaid();
+        auto prepaid_s = config().get_pro_prepaid();
         std::optional<std::chrono::sys_time<std::chrono::milliseconds>> prepaid_ms;
         if (prepaid_s)
             prepaid_ms = std::chrono::sys_time<std::chrono::milliseconds>(
@@ -458,7 +462,7 @@ void UserConfigWrapper::setProPrepaid(const Napi::CallbackInfo& info) {
         std::optional<std::chrono::sys_seconds> prepaid;
         if (prepaid_ms)
             prepaid = std::chrono::floor<std::chrono::seconds>(*prepaid_ms);
-        config.set_pro_prepaid(prepaid);
+        config().set_pro_prepaid(prepaid);
     });
 }
 
@@ -467,7 +471,7 @@ Napi::Value UserConfigWrapper::getProRenewalTarget(const Napi::CallbackInfo& inf
         assertInfoLength(info, 1);
         auto now = std::chrono::floor<std::chrono::seconds>(
                 toCppSysMs(info[0], "UserConfigWrapper::getProRenewalTarget"));
-        auto target_s = config.pro_renewal_target(now);
+        auto target_s = config().pro_renewal_target(now);
         std::optional<std::chrono::sys_time<std::chrono::milliseconds>> target_ms;
         if (target_s)
             target_ms = std::chrono::sys_time<std::chrono::milliseconds>(
@@ -8,6 +8,7 @@
 
 #include "base_config.hpp"
 #include "community.hpp"
+#include "cursor.hpp"
 #include "session/config/user_groups.hpp"
 #include "session/types.hpp"
 
@@ -18,71 +19,120 @@ using config::group_info;
 using config::legacy_group_info;
 using config::UserGroups;
 
+static constexpr auto community_info_fields = field_table<community_info>({
+        {"fullUrlWithPubkey",
+         [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.full_url()); }},
+        {"baseUrl", [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.base_url()); }},
+        {"roomCasePreserved",
+         [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.room()); }},
+        {"pubkeyHex", [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.pubkey_hex()); }},
+        {"priority", [](auto& env, auto& c) -> Napi::Value { return toJs(env, c.priority); }},
+});
+
 template <>
-struct toJs_impl<community_info> : toJs_impl<config::community> {
-    Napi::Object operator()(const Napi::Env& env, const community_info& info_comm) {
-        auto obj = toJs_impl<config::community>::operator()(env, info_comm);
-        obj["priority"] = toJs(env, info_comm.priority);
+struct entity_fields<community_info> {
+    static constexpr const auto& fields = community_info_fields;
+};
 
-        return obj;
+template <>
+struct toJs_impl<community_info> {
+    Napi::Object operator()(const Napi::Env& env, const community_info& info_comm) {
+        return community_info_fields.to_js(env, info_comm);
     }
 };
 
+static constexpr ObjectShape legacy_group_member_shape{"pubkeyHex", "isAdmin"};
+
 static Napi::Array members_array(const Napi::Env& env, const std::map<std::string, bool>& members) {
     auto mems = Napi::Array::New(env, members.size());
+    auto keys = legacy_group_member_shape.keys(env);
     size_t i = 0;
-    for (const auto& [session_id, is_admin] : members) {
-        auto mem = Napi::Object::New(env);
-        mem["pubkeyHex"] = toJs(env, session_id);
-        mem["isAdmin"] = toJs(env, is_admin);
-        mems[i++] = std::move(mem);
-    }
+    for (const auto& [session_id, is_admin] : members)
+        mems[i++] = legacy_group_member_shape.make_with_keys(
+                env, keys, toJs(env, session_id), toJs(env, is_admin));
     return mems;
 }
 
+static constexpr auto legacy_group_fields = field_table<legacy_group_info>({
+        {"pubkeyHex", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.session_id); }},
+        {"name", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.name); }},
+        {"encPubkey", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.enc_pubkey); }},
+        {"encSeckey", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.enc_seckey); }},
+        {"disappearingTimerSeconds",
+         [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.disappearing_timer.count()); }},
+        {"priority", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.priority); }},
+        {"joinedAtSeconds",
+         [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.joined_at); }},
+        {"members",
+         [](auto& env, auto& g) -> Napi::Value { return members_array(env, g.members()); }},
+});
+
+template <>
+struct entity_fields<legacy_group_info> {
+    static constexpr const auto& fields = legacy_group_fields;
+};
+
 template <>
 struct toJs_impl<legacy_group_info> {
     Napi::Object operator()(const Napi::Env& env, const legacy_group_info& legacy_group) {
-        auto obj = Napi::Object::New(env);
-
-        obj["pubkeyHex"] = toJs(env, legacy_group.session_id);
-        obj["name"] = toJs(env, legacy_group.name);
-        obj["encPubkey"] = toJs(env, legacy_group.enc_pubkey);
-        obj["encSeckey"] = toJs(env, legacy_group.enc_seckey);
-        obj["disappearingTimerSeconds"] = toJs(env, legacy_group.disappearing_timer.count());
-        obj["priority"] = toJs(env, legacy_group.priority);
-        obj["joinedAtSeconds"] = toJs(env, legacy_group.joined_at);
-        obj["members"] = members_array(env, legacy_group.members());
-
-        return obj;
+        return legacy_group_fields.to_js(env, legacy_group);
     }
 };
 
+static constexpr auto group_fields = field_table<group_info>({
+        {"pubkeyHex", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.id); }},
+        {"secretKey", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.secretkey); }},
+        {"priority", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.priority); }},
+        {"joinedAtSeconds",
+         [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.joined_at); }},
+        {"name", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.name); }},
+        {"authData", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.auth_data); }},
+        {"invitePending", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.invited); }},
+        {"kicked", [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.kicked()); }},
+        {"destroyed",
+         [](auto& env, auto& g) -> Napi::Value { return toJs(env, g.is_destroyed()); }},
+});
+
+template <>
+struct entity_fields<group_info> {
+    static constexpr const auto& fields = group_fields;
+};
+
 template <>
 struct toJs_impl<group_info> {
     Napi::Object operator()(const Napi::Env& env, const group_info& info) {
-        auto obj = Napi::Object::New(env);
-
-        obj["pubkeyHex"] = toJs(env, info.id);
-        obj["secretKey"] = toJs(env, info.secretkey);
-        obj["priority"] = toJs(env, info.priority);
-        obj["joinedAtSeconds"] = toJs(env, info.joined_at);
-        obj["name"] = toJs(env, info.name);
-        obj["authData"] = toJs(env, info.auth_data);
-        obj["invitePending"] = toJs(env, info.invited);
-        obj["kicked"] = toJs(env, info.kicked());
-        obj["destroyed"] = toJs(env, info.is_destroyed());
-
-        return obj;
+        return group_fields.to_js(env, info);
     }
 };
 
+// The keys and fingerprints of the groups and communities, for the change sets of merge().
+static std::pair<std::string, uint64_t> community_fingerprint(const community_info& c) {
+    return {c.full_url(), Fingerprint{}.add(c.room(), c.priority).value()};
+}
+
+static std::pair<std::string, uint64_t> legacy_group_fingerprint(const legacy_group_info& g) {
+    Fingerprint fp;
+    fp.add(g.name, g.enc_pubkey, g.enc_seckey, g.disappearing_timer, g.priority, g.joined_at);
+    for (const auto& [session_id, is_admin] : g.members())
+        fp.add(session_id, is_admin);
+    return {g.session_id, fp.value()};
+}
+
+static std::pair<std::string, uint64_t> group_fingerprint(const group_info& g) {
+    Fingerprint fp;
+    fp.add(g.secretkey, g.priority, g.joined_at, g.name, g.auth_data, g.invited);
+    fp.add(g.kicked(), g.is_destroyed());
+    return {g.id, fp.value()};
+}
+
 void UserGroupsWrapper::Init(Napi::Env env, Napi::Object exports) {
     InitHelper<UserGroupsWrapper>(
             env,
             exports,
             "UserGroupsWrapperNode",
             {
+                    StaticMethod<&createAsync<UserGroupsWrapper, UserGroups>>("createAsync"),
+
                     // Communities related methods
                     InstanceMethod(
                             "getCommunityByFullUrl", &UserGroupsWrapper::getCommunityByFullUrl),
@@ -110,11 +160,27 @@ void UserGroupsWrapper::Init(Napi::Env env, Napi::Object exports) {
                     InstanceMethod("markGroupDestroyed", &UserGroupsWrapper::markGroupDestroyed),
                     InstanceMethod("eraseGroup", &UserGroupsWrapper::eraseGroup),
 
+                    // Batched iteration over any of the above
+                    InstanceMethod("iterate", &UserGroupsWrapper::iterate),
+
             });
 }
 
+// The collection fingerprints of a UserGroups config (see config_fingerprinter).
+static config_fingerprints user_groups_fingerprints(config::ConfigBase& base) {
+    auto& conf = static_cast<UserGroups&>(base);
+    return {
+            {"community",
+             fingerprint_all(conf.begin_communities(), conf.end(), community_fingerprint)},
+            {"legacyGroup",
+             fingerprint_all(conf.begin_legacy_groups(), conf.end(), legacy_group_fingerprint)},
+            {"group", fingerprint_all(conf.begin_groups(), conf.end(), group_fingerprint)},
+    };
+}
+
 UserGroupsWrapper::UserGroupsWrapper(const Napi::CallbackInfo& info) :
-        ConfigBaseImpl{construct<UserGroups>(info, "UserGroups")},
+        ConfigBaseImpl{
+                construct<UserGroups>(info, CLASS_NAME), CLASS_NAME, user_groups_fingerprints},
         Napi::ObjectWrap<UserGroupsWrapper>{info} {}
 
 /**
@@ -124,7 +190,7 @@ UserGroupsWrapper::UserGroupsWrapper(const Napi::CallbackInfo& info) :
  */
 
 Napi::Value UserGroupsWrapper::getCommunityByFullUrl(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return config.get_community(getStringArgs<1>(info)); });
+    return wrapResult(info, [&] { return config().get_community(getStringArgs<1>(info)); });
 }
 
 void UserGroupsWrapper::setCommunityByFullUrl(const Napi::CallbackInfo& info) {
@@ -132,25 +198,30 @@ void UserGroupsWrapper::setCommunityByFullUrl(const Napi::CallbackInfo& info) {
         assertInfoLength(info, 2);
         auto first = info[0];
         assertIsString(first);
-        auto createdOrFound = config.get_or_construct_community(
+        auto createdOrFound = config().get_or_construct_community(
                 toCppString(first, "group.SetCommunityByFullUrl"));
 
         auto second = info[1];
         assertIsNumber(second, "setCommunityByFullUrl");
         createdOrFound.priority = toPriority(second, createdOrFound.priority);
 
-        config.set(createdOrFound);
+        mutated();
+        config().set(createdOrFound);
     });
 }
 
 Napi::Value UserGroupsWrapper::getAllCommunities(const Napi::CallbackInfo& info) {
-    return get_all_impl(info, config.size_communities(), config.begin_communities(), config.end());
+    return wrapResult(info, [&] {
+        auto& conf = config();
+        return get_all_impl(info, conf.size_communities(), conf.begin_communities(), conf.end());
+    });
 }
 
 Napi::Value UserGroupsWrapper::eraseCommunityByFullUrl(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
         auto [base, room, pubkey] = config::community::parse_full_url(getStringArgs<1>(info));
-        return config.erase_community(base, room);
+        mutated();
+        return config().erase_community(base, room);
     });
 }
 
@@ -175,12 +246,15 @@ Napi::Value UserGroupsWrapper::buildFullUrlFromDetails(const Napi::CallbackInfo&
  */
 
 Napi::Value UserGroupsWrapper::getLegacyGroup(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return config.get_legacy_group(getStringArgs<1>(info)); });
+    return wrapResult(info, [&] { return config().get_legacy_group(getStringArgs<1>(info)); });
 }
 
 Napi::Value UserGroupsWrapper::getAllLegacyGroups(const Napi::CallbackInfo& info) {
-    return get_all_impl(
-            info, config.size_legacy_groups(), config.begin_legacy_groups(), config.end());
+    return wrapResult(info, [&] {
+        auto& conf = config();
+        return get_all_impl(
+                info, conf.size_legacy_groups(), conf.begin_legacy_groups(), conf.end());
+    });
 }
 
 void UserGroupsWrapper::setLegacyGroup(const Napi::CallbackInfo& info) {
@@ -191,7 +265,7 @@ void UserGroupsWrapper::setLegacyGroup(const Napi::CallbackInfo& info) {
         assertIsObject(legacyGroupValue);
         auto obj = legacyGroupValue.As<Napi::Object>();
 
-        auto group = config.get_or_construct_legacy_group(
+        auto group = config().get_or_construct_legacy_group(
                 toCppString(obj.Get("pubkeyHex"), "legacyGroup.set"));
 
         group.priority = toPriority(obj.Get("priority"), group.priority);
@@ -261,12 +335,16 @@ void UserGroupsWrapper::setLegacyGroup(const Napi::CallbackInfo& info) {
             group.erase(sid);
         }
 
-        config.set(group);
+        mutated();
+        config().set(group);
     });
 }
 
 Napi::Value UserGroupsWrapper::eraseLegacyGroup(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return config.erase_legacy_group(getStringArgs<1>(info)); });
+    return wrapResult(info, [&] {
+        mutated();
+        return config().erase_legacy_group(getStringArgs<1>(info));
+    });
 }
 
 /**
@@ -276,16 +354,19 @@ Napi::Value UserGroupsWrapper::eraseLegacyGroup(const Napi::CallbackInfo& info)
  */
 
 Napi::Value UserGroupsWrapper::createGroup(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return config.create_group(); });
+    return wrapResult(info, [&] { return config().create_group(); });
 }
 
 Napi::Value UserGroupsWrapper::getGroup(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return config.get_group(getStringArgs<1>(info)); });
+    return wrapResult(info, [&] { return config().get_group(getStringArgs<1>(info)); });
 }
 
 Napi::Value UserGroupsWrapper::getAllGroups(const Napi::CallbackInfo& info) {
 
-    return get_all_impl(info, config.size_groups(), config.begin_groups(), config.end());
+    return wrapResult(info, [&] {
+        auto& conf = config();
+        return get_all_impl(info, conf.size_groups(), conf.begin_groups(), conf.end());
+    });
 }
 
 Napi::Value UserGroupsWrapper::setGroup(const Napi::CallbackInfo& info) {
@@ -304,7 +385,7 @@ Napi::Value UserGroupsWrapper::setGroup(const Napi::CallbackInfo& info) {
         // Otherwise, use the corresponding value to update what we got from the
         // `get_or_construct_group` below
 
-        auto group_info = config.get_or_construct_group(groupPk);
+        auto group_info = config().get_or_construct_group(groupPk);
 
         if (auto priority =
                     maybeNonemptyInt(obj.Get("priority"), "UserGroupsWrapper::setGroup priority")) {
@@ -339,9 +420,10 @@ Napi::Value UserGroupsWrapper::setGroup(const Napi::CallbackInfo& info) {
             group_info.name = *name;
         }
 
-        config.set(group_info);
+        mutated();
+        config().set(group_info);
 
-        return config.get_or_construct_group(groupPk);
+        return config().get_or_construct_group(groupPk);
     });
 }
 
@@ -349,12 +431,13 @@ Napi::Value UserGroupsWrapper::markGroupKicked(const Napi::CallbackInfo& info) {
     return wrapResult(info, [&] {
         auto groupPk = getStringArgs<1>(info);
 
-        auto group = config.get_group(groupPk);
+        auto group = config().get_group(groupPk);
         if (group) {
             group->mark_kicked();
-            config.set(*group);
+            mutated();
+            config().set(*group);
         }
-        return config.get_or_construct_group(groupPk);
+        return config().get_or_construct_group(groupPk);
     });
 }
 
@@ -362,12 +445,13 @@ Napi::Value UserGroupsWrapper::markGroupInvited(const Napi::CallbackInfo& info)
     return wrapResult(info, [&] {
         auto groupPk = getStringArgs<1>(info);
 
-        auto group = config.get_group(groupPk);
+        auto group = config().get_group(groupPk);
         if (group) {
             group->mark_invited();
-            config.set(*group);
+            mutated();
+            config().set(*group);
         }
-        return config.get_or_construct_group(groupPk);
+        return config().get_or_construct_group(groupPk);
     });
 }
 
@@ -375,17 +459,45 @@ Napi::Value UserGroupsWrapper::markGroupDestroyed(const Napi::CallbackInfo& info
     return wrapResult(info, [&] {
         auto groupPk = getStringArgs<1>(info);
 
-        auto group = config.get_group(groupPk);
+        auto group = config().get_group(groupPk);
         if (group) {
             group->mark_destroyed();
-            config.set(*group);
+            mutated();
+            config().set(*group);
         }
-        return config.get_or_construct_group(groupPk);
+        return config().get_or_construct_group(groupPk);
     });
 }
 
 Napi::Value UserGroupsWrapper::eraseGroup(const Napi::CallbackInfo& info) {
-    return wrapResult(info, [&] { return config.erase_group(getStringArgs<1>(info)); });
+    return wrapResult(info, [&] {
+        mutated();
+        return config().erase_group(getStringArgs<1>(info));
+    });
+}
+
+/**
+ * =================================================
+ * ==================== CURSORS ====================
+ * =================================================
+ */
+
+Napi::Value UserGroupsWrapper::iterate(const Napi::CallbackInfo& info) {
+    return wrapResult(info, [&] {
+        checkOrThrow(info.Length() <= 1, "Invalid number of arguments");
+        auto opts = cursor_options_from_JS(info[0]);
+        auto& conf = config();
+        auto type = opts.type.value_or("");
+        if (type == "community")
+            return make_entity_cursor(
+                    info, cursor_guard(), opts, conf.begin_communities(), conf.end());
+        if (type == "legacyGroup")
+            return make_entity_cursor(
+                    info, cursor_guard(), opts, conf.begin_legacy_groups(), conf.end());
+        if (type == "group")
+            return make_entity_cursor(info, cursor_guard(), opts, conf.begin_groups(), conf.end());
+        throw std::invalid_argument{"iterate: type must be one of community, legacyGroup, group"};
+    });
 }
 
 }  // namespace session::nodeapi
@@ -120,6 +120,7 @@ std::span<const unsigned char> toCppBufferView(Napi::Value x, const std::string&
         throw std::invalid_argument{"toCppBuffer unsupported type with identifier: " + identifier};
 
     auto u8Array = x.As<Napi::Uint8Array>();
+    instrumentation::count_bytes_in(u8Array.ByteLength());
     return {u8Array.Data(), u8Array.ByteLength()};
 }
 
@@ -127,6 +128,23 @@ std::vector<unsigned char> toCppBuffer(Napi::Value x, const std::string& identif
     return session::to_vector(toCppBufferView(x, std::move(identifier)));
 }
 
+Napi::Buffer<uint8_t> toJsBuffer(const Napi::Env& env, std::vector<unsigned char>&& b) {
+    instrumentation::count_bytes_out(b.size());
+    if (b.size() < EXTERNAL_BUFFER_MIN_SIZE)
+        return Napi::Buffer<uint8_t>::Copy(env, b.data(), b.size());
+
+    // Moving the vector onto the heap keeps its storage where it is; the finalizer frees it once
+    // JS is done with the Buffer.  NewOrCopy falls back to a copy (finalizing straight away) on
+    // runtimes that disallow external buffers, such as Electron.
+    auto* owned = new std::vector<unsigned char>{std::move(b)};
+    return Napi::Buffer<uint8_t>::NewOrCopy(
+            env,
+            owned->data(),
+            owned->size(),
+            [](Napi::Env, uint8_t*, std::vector<unsigned char>* v) { delete v; },
+            owned);
+}
+
 std::optional<std::vector<unsigned char>> maybeNonemptyBuffer(
         Napi::Value x, const std::string& identifier) {
     if (x.IsNull() || x.IsUndefined())
@@ -338,12 +356,12 @@ int64_t unix_timestamp_now() {
 
 Napi::Object push_result_to_JS(
         const Napi::Env& env,
-        const push_entry_t& push_entry,
+        push_entry_t push_entry,
         const session::config::Namespace& push_namespace) {
     auto obj = Napi::Object::New(env);
 
     obj["seqno"] = toJs(env, std::get<0>(push_entry));
-    obj["data"] = toJs(env, std::get<1>(push_entry));
+    obj["data"] = toJs(env, std::move(std::get<1>(push_entry)));
     obj["hashes"] = toJs(env, std::get<2>(push_entry));
     obj["namespace"] = toJs(env, push_namespace);
 
@@ -391,6 +409,14 @@ confirm_pushed_entry_t confirm_pushed_entry_from_JS(const Napi::Env& env, const
     return confirmed_pushed_entry;
 }
 
+void merge_entries::add(
+        std::string hash, const Napi::Value& data, bool copy, const std::string& identifier) {
+    auto view = toCppBufferView(data, identifier);
+    if (copy)
+        view = owned.emplace_back(view.begin(), view.end());
+    configs.emplace_back(std::move(hash), view);
+}
+
 Napi::BigInt proProfileBitsetToJS(const Napi::Env& env, const ProProfileBitset bitset) {
     return Napi::BigInt::New(env, bitset.data);
 }
@@ -77,14 +77,56 @@ declare module 'libsession_util_nodejs' {
     nominatedAdmin: boolean;
   };
 
+  /**
+   * One change of `membersApply`: `op` is the setter to apply to the member (e.g. `inviteSent` for
+   * `memberSetInviteSent`), with the extra arguments that setter takes, if any.
+   */
+  type GroupMemberChange = { pubkeyHex: PubkeyType } & (
+    | {
+        op:
+          | 'inviteSent'
+          | 'inviteNotSent'
+          | 'inviteFailed'
+          | 'inviteAccepted'
+          | 'promoted'
+          | 'promotionSent'
+          | 'promotionFailed'
+          | 'promotionAccepted'
+          | 'supplement';
+      }
+    | {
+        op: 'profileDetails';
+        profileUpdatedSeconds: number;
+        name: string;
+        profilePicture: ProfilePicture;
+      }
+    | { op: 'pendingRemoval'; withMessages: boolean }
+  );
+
   type GroupMemberWrapper = {
     // GroupMember related methods
     memberGet: (pubkeyHex: PubkeyType) => GroupMemberGet | null;
     memberGetOrConstruct: (pubkeyHex: PubkeyType) => GroupMemberGet;
     memberConstructAndSet: (pubkeyHex: PubkeyType) => void;
 
-    memberGetAll: () => Array<GroupMemberGet>;
-    memberGetAllPendingRemovals: () => Array<GroupMemberGet>;
+    memberGetAll: GetAllWithFields<GroupMemberGet>;
+    memberGetAllPendingRemovals: GetAllWithFields<GroupMemberGet>;
+    /**
+     * The number of members having each status. Kept up to date natively, so this does not go
+     * through all the members.
+     */
+    /**
+     * All the members, with only their pubkey and status, in a compact form: member `i` has the
+     * 33-byte pubkey at `pubkeys[i * 33, (i + 1) * 33)` and the status code `statuses[i]`, the
+     * codes being those of `CONSTANTS.MEMBER_STATUS`.
+     */
+    memberGetAllCompact: () => { count: number; pubkeys: Uint8Array; statuses: Uint8Array };
+    memberCountsByStatus: () => Record<MemberStateGroupV2, number>;
+    /** The members having any of `statuses`, sorted by pubkey, optionally with only `fields`. */
+    memberGetByStatus: <F extends keyof GroupMemberGet = keyof GroupMemberGet>(
+      statuses: Array<MemberStateGroupV2>,
+      fields?: Array<F>
+    ) => Array<Pick<GroupMemberGet, F>>;
 
     // setters
 
@@ -127,6 +169,14 @@ declare module 'libsession_util_nodejs' {
     memberResetAllSendingState: () => boolean;
     memberSetSupplement: (pubkeyHex: PubkeyType) => void;
     membersMarkPendingRemoval: (members: Array<PubkeyType>, withMessages: boolean) => void;
+    /**
+     * Applies a batch of the changes of the setters above, in one call. Changes to unknown members
+     * are ignored, and nothing is applied if any change is invalid.
+     * @returns the pubkeys of the members saved: the known ones with at least one change applied
+     * (like `memberSetProfileDetails`, a `profileDetails` change older than the member's profile
+     * is not applied)
+     */
+    membersApply: (changes: Array<GroupMemberChange>) => Array<PubkeyType>;
 
     // eraser
     memberEraseAndRekey: (members: Array<PubkeyType>) => boolean;
@@ -26,6 +26,12 @@ declare module 'libsession_util_nodejs' {
     metaDumped: Uint8Array | null;
   };
 
+  export type MetaMergeArgs = {
+    groupInfo: Array<MergeSingle> | null;
+    groupMember: Array<MergeSingle> | null;
+    groupKeys: Array<MergeSingle & { timestampMs: number }> | null;
+  };
+
   type MetaGroupWrapper = GroupInfoWrapper &
     GroupMemberWrapper &
     GroupKeysWrapper & {
@@ -89,15 +95,32 @@ declare module 'libsession_util_nodejs' {
        * to be encrypted to us, which is not a failure. So this detects a lossy groupInfo or
        * groupMember merge, which is what matters.
        */
-      metaMerge: ({
-        groupInfo,
-        groupKeys,
-        groupMember,
-      }: {
-        groupInfo: Array<MergeSingle> | null;
-        groupMember: Array<MergeSingle> | null;
-        groupKeys: Array<MergeSingle & { timestampMs: number }> | null;
-      }) => number;
+      metaMerge: {
+        /** Also returns the changes to the members (see `ConfigChanges`). */
+        (
+          toMerge: MetaMergeArgs,
+          options: { changeSet: true }
+        ): { count: number; changes: Pick<ConfigChanges, 'member'> };
+        (
+          { groupInfo, groupKeys, groupMember }: MetaMergeArgs,
+          options?: { changeSet?: boolean }
+        ): number;
+      };
+      /**
+       * Same as `metaMerge`, but the keys, info and members merges (and the rekey, if needed) run on
+       * the libuv threadpool, as does computing the change set with `{ changeSet: true }`. Any
+       * other call on this wrapper throws until the promise settles.
+       */
+      metaMergeAsync: {
+        (
+          toMerge: MetaMergeArgs,
+          options: { changeSet: true }
+        ): Promise<{ count: number; rekeyed: boolean; changes: Pick<ConfigChanges, 'member'> }>;
+        (
+          toMerge: MetaMergeArgs,
+          options?: { changeSet?: boolean }
+        ): Promise<{ count: number; rekeyed: boolean }>;
+      };
     };
 
   // this just adds an argument of type GroupPubkeyType in front of the parameters of that function
@@ -110,7 +133,30 @@ declare module 'libsession_util_nodejs' {
   }>;
 
   export class MetaGroupWrapperNode {
+    /**
+     * When given a `metaDumped`, the group is only loaded by the first call needing it:
+     * `needsPush`, `needsDump`, `metaDump`, `metaMakeDump` and `activeHashes*` are answered from
+     * the dump until then, and an invalid config dump in it only throws from that first call.
+     * A dump made by an older version cannot answer them: `needsDump` is then true until it is
+     * saved again.
+     */
     constructor(options: GroupWrapperConstructor);
+    /**
+     * Same as the constructor, but the group is loaded (its dumps parsed, its keys constructed and
+     * verified) on the libuv threadpool, so that loading many groups does not block the calling
+     * thread.
+     */
+    public static createAsync(options: GroupWrapperConstructor): Promise<MetaGroupWrapperNode>;
+    /**
+     * Loads many groups at once, in parallel on the libuv threadpool.
+     * A group failing to load (or given invalid options) does not stop the others from loading.
+     * @returns one entry per group, in the order of `options`
+     */
+    public static loadMany(
+      options: Array<GroupWrapperConstructor>
+    ): Promise<
+      Array<{ group: MetaGroupWrapperNode; error: null } | { group: null; error: string }>
+    >;
 
     // shared actions
     public needsPush: MetaGroupWrapper['needsPush'];
@@ -121,6 +167,7 @@ declare module 'libsession_util_nodejs' {
     public metaMakeDump: MetaGroupWrapper['metaMakeDump'];
     public metaConfirmPushed: MetaGroupWrapper['metaConfirmPushed'];
     public metaMerge: MetaGroupWrapper['metaMerge'];
+    public metaMergeAsync: MetaGroupWrapper['metaMergeAsync'];
     public activeHashes: MetaGroupWrapper['activeHashes'];
     public activeHashesByConfig: MetaGroupWrapper['activeHashesByConfig'];
 
@@ -135,6 +182,10 @@ declare module 'libsession_util_nodejs' {
     public memberConstructAndSet: MetaGroupWrapper['memberConstructAndSet'];
     public memberGetAll: MetaGroupWrapper['memberGetAll'];
     public memberGetAllPendingRemovals: MetaGroupWrapper['memberGetAllPendingRemovals'];
+    public memberGetAllCompact: MetaGroupWrapper['memberGetAllCompact'];
+    public memberCountsByStatus: MetaGroupWrapper['memberCountsByStatus'];
+    public memberGetByStatus: MetaGroupWrapper['memberGetByStatus'];
+    public memberIterate: Iterate<GroupMemberGet>;
     public memberSetInviteAccepted: MetaGroupWrapper['memberSetInviteAccepted'];
     public memberSetPromoted: MetaGroupWrapper['memberSetPromoted'];
     public memberSetPromotionAccepted: MetaGroupWrapper['memberSetPromotionAccepted'];
@@ -148,6 +199,7 @@ declare module 'libsession_util_nodejs' {
     public memberSetProfileDetails: MetaGroupWrapper['memberSetProfileDetails'];
     public memberResetAllSendingState: MetaGroupWrapper['memberResetAllSendingState'];
     public memberSetSupplement: MetaGroupWrapper['memberSetSupplement'];
+    public membersApply: MetaGroupWrapper['membersApply'];
 
     // keys
     public keysNeedsRekey: MetaGroupWrapper['keysNeedsRekey'];
@@ -173,6 +225,7 @@ declare module 'libsession_util_nodejs' {
     | MakeActionCall<MetaGroupWrapper, 'metaMakeDump'>
     | MakeActionCall<MetaGroupWrapper, 'metaConfirmPushed'>
     | MakeActionCall<MetaGroupWrapper, 'metaMerge'>
+    | MakeActionCall<MetaGroupWrapper, 'metaMergeAsync'>
     | MakeActionCall<MetaGroupWrapper, 'free'>
 
     // info actions
@@ -186,6 +239,9 @@ declare module 'libsession_util_nodejs' {
     | MakeActionCall<MetaGroupWrapper, 'memberConstructAndSet'>
     | MakeActionCall<MetaGroupWrapper, 'memberGetAll'>
     | MakeActionCall<MetaGroupWrapper, 'memberGetAllPendingRemovals'>
+    | MakeActionCall<MetaGroupWrapper, 'memberGetAllCompact'>
+    | MakeActionCall<MetaGroupWrapper, 'memberCountsByStatus'>
+    | MakeActionCall<MetaGroupWrapper, 'memberGetByStatus'>
     | MakeActionCall<MetaGroupWrapper, 'memberSetInviteAccepted'>
     | MakeActionCall<MetaGroupWrapper, 'memberSetPromoted'>
     | MakeActionCall<MetaGroupWrapper, 'memberSetPromotionFailed'>
@@ -199,6 +255,7 @@ declare module 'libsession_util_nodejs' {
     | MakeActionCall<MetaGroupWrapper, 'memberSetProfileDetails'>
     | MakeActionCall<MetaGroupWrapper, 'memberResetAllSendingState'>
     | MakeActionCall<MetaGroupWrapper, 'memberSetSupplement'>
+    | MakeActionCall<MetaGroupWrapper, 'membersApply'>
 
     // keys actions
     | MakeActionCall<MetaGroupWrapper, 'keysNeedsRekey'>
@@ -1,6 +1,8 @@
 /// <reference path="./utilities/index.d.ts" />
 /// <reference path="./blinding/index.d.ts" />
 /// <reference path="./groups/index.d.ts" />
+/// <reference path="./instrumentation/index.d.ts" />
+/// <reference path="./logger/index.d.ts" />
 /// <reference path="./multi_encrypt/index.d.ts" />
 /// <reference path="./pro/pro.d.ts" />
 /// <reference path="./user/index.d.ts" />
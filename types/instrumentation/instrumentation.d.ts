@@ -0,0 +1,56 @@
+/// <reference path="../shared.d.ts" />
+
+declare module 'libsession_util_nodejs' {
+  export type MethodStats = {
+    calls: number;
+    /** Number of calls that threw */
+    errors: number;
+    totalMs: number;
+    meanMs: number;
+    /** Percentiles are approximations, accurate to ~6% */
+    p50Ms: number;
+    p99Ms: number;
+    maxMs: number;
+    /** Bytes of Uint8Array arguments read by the call */
+    bytesIn: number;
+    /** Bytes of Uint8Array results created by the call */
+    bytesOut: number;
+  };
+
+  type InstrumentationWrapper = {
+    /**
+     * Starts or stops recording per-method statistics. Disabled by default, in which case the
+     * overhead is negligible. Disabling keeps what was recorded until `resetStats()`.
+     *
+     * Only the synchronous part of the calls is measured: the background work of the `*Async`
+     * methods is not.
+     */
+    setEnabled: (enabled: boolean) => void;
+    /**
+     * Returns the statistics recorded so far, keyed by method name (e.g.
+     * `MetaGroupWrapper::metaMerge`). The methods all the config wrappers have are keyed by the
+     * wrapper they were called on (e.g. `ContactsConfigWrapper::merge`,
+     * `UserGroupsWrapper::createAsync`).
+     */
+    getStats: () => Record<string, MethodStats>;
+    resetStats: () => void;
+  };
+
+  export type InstrumentationActionsCalls = MakeWrapperActionCalls<InstrumentationWrapper>;
+
+  export class InstrumentationWrapperNode {
+    public static setEnabled: InstrumentationWrapper['setEnabled'];
+    public static getStats: InstrumentationWrapper['getStats'];
+    public static resetStats: InstrumentationWrapper['resetStats'];
+  }
+
+  /**
+   * Those actions are used internally for the web worker communication.
+   * You should never need to import them in Session directly
+   * You will need to add an entry here if you add a new function
+   */
+  export type InstrumentationActionsType =
+    | MakeActionCall<InstrumentationWrapper, 'setEnabled'>
+    | MakeActionCall<InstrumentationWrapper, 'getStats'>
+    | MakeActionCall<InstrumentationWrapper, 'resetStats'>;
+}
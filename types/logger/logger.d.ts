@@ -0,0 +1,29 @@
+/// <reference path="../shared.d.ts" />
+
+declare module 'libsession_util_nodejs' {
+  export type LogLevel = 'trace' | 'debug' | 'info' | 'warning' | 'error' | 'critical' | 'off';
+
+  type LoggerWrapper = {
+    /**
+     * Sets the level of a single log category, or of every category when `category` is null.
+     * Records below the level are discarded before being formatted, so they never reach JS.
+     *
+     * The warnings logged by this module itself (e.g. the decryptFor* failures) are under the
+     * `nodeapi` category.
+     */
+    setLogLevel: (category: string | null, level: LogLevel) => void;
+  };
+
+  export type LoggerActionsCalls = MakeWrapperActionCalls<LoggerWrapper>;
+
+  export class LoggerWrapperNode {
+    public static setLogLevel: LoggerWrapper['setLogLevel'];
+  }
+
+  /**
+   * Those actions are used internally for the web worker communication.
+   * You should never need to import them in Session directly
+   * You will need to add an entry here if you add a new function
+   */
+  export type LoggerActionsType = MakeActionCall<LoggerWrapper, 'setLogLevel'>;
+}
@@ -166,6 +166,30 @@ declare module 'libsession_util_nodejs' {
       >
     ) => { encryptedData: Array<Uint8Array> };
 
+    /**
+     * Same as `encryptFor1o1`, but the batch is encrypted on the libuv threadpool, across several
+     * threads. `encryptedData` is in input order.
+     */
+    encryptFor1o1Async: (
+      ...args: Parameters<MultiEncryptWrapper['encryptFor1o1']>
+    ) => Promise<ReturnType<MultiEncryptWrapper['encryptFor1o1']>>;
+
+    /**
+     * Same as `encryptForCommunity`, but the batch is encrypted on the libuv threadpool, across
+     * several threads. `encryptedData` is in input order.
+     */
+    encryptForCommunityAsync: (
+      ...args: Parameters<MultiEncryptWrapper['encryptForCommunity']>
+    ) => Promise<ReturnType<MultiEncryptWrapper['encryptForCommunity']>>;
+
+    /**
+     * Same as `encryptForGroup`, but the batch is encrypted on the libuv threadpool, across several
+     * threads. `encryptedData` is in input order.
+     */
+    encryptForGroupAsync: (
+      ...args: Parameters<MultiEncryptWrapper['encryptForGroup']>
+    ) => Promise<ReturnType<MultiEncryptWrapper['encryptForGroup']>>;
+
     decryptForCommunity: (
       first: Array<WithContentOrEnvelope & WithServerId>,
       second: WithNowMs & WithProBackendPubkey
@@ -180,6 +204,22 @@ declare module 'libsession_util_nodejs' {
       first: Array<WithEnvelopePayload & WithMessageHash>,
       second:  WithProBackendPubkey & WithEd25519GroupPubkeyHex & WithGroupEncryptionKeys
     ) => Array<WithDecodedEnvelope & WithMessageHash>;
+
+    /**
+     * Same as `decryptFor1o1`, but the batch is decrypted on the libuv threadpool, across several
+     * threads. Order is preserved and messages failing to decrypt are skipped (with a warning).
+     */
+    decryptFor1o1Async: (
+      ...args: Parameters<MultiEncryptWrapper['decryptFor1o1']>
+    ) => Promise<ReturnType<MultiEncryptWrapper['decryptFor1o1']>>;
+
+    /**
+     * Same as `decryptForGroup`, but the batch is decrypted on the libuv threadpool, across several
+     * threads. Order is preserved and messages failing to decrypt are skipped (with a warning).
+     */
+    decryptForGroupAsync: (
+      ...args: Parameters<MultiEncryptWrapper['decryptForGroup']>
+    ) => Promise<ReturnType<MultiEncryptWrapper['decryptForGroup']>>;
   };
 
   export type MultiEncryptActionsCalls = MakeWrapperActionCalls<MultiEncryptWrapper>;
@@ -196,10 +236,15 @@ declare module 'libsession_util_nodejs' {
     public static encryptForCommunityInbox: MultiEncryptWrapper['encryptForCommunityInbox'];
     public static encryptForCommunity: MultiEncryptWrapper['encryptForCommunity'];
     public static encryptForGroup: MultiEncryptWrapper['encryptForGroup'];
+    public static encryptFor1o1Async: MultiEncryptWrapper['encryptFor1o1Async'];
+    public static encryptForCommunityAsync: MultiEncryptWrapper['encryptForCommunityAsync'];
+    public static encryptForGroupAsync: MultiEncryptWrapper['encryptForGroupAsync'];
 
     public static decryptForCommunity: MultiEncryptWrapper['decryptForCommunity'];
     public static decryptFor1o1: MultiEncryptWrapper['decryptFor1o1'];
     public static decryptForGroup: MultiEncryptWrapper['decryptForGroup'];
+    public static decryptFor1o1Async: MultiEncryptWrapper['decryptFor1o1Async'];
+    public static decryptForGroupAsync: MultiEncryptWrapper['decryptForGroupAsync'];
   }
 
   /**
@@ -216,7 +261,12 @@ declare module 'libsession_util_nodejs' {
     | MakeActionCall<MultiEncryptWrapper, 'encryptForCommunityInbox'>
     | MakeActionCall<MultiEncryptWrapper, 'encryptForCommunity'>
     | MakeActionCall<MultiEncryptWrapper, 'encryptForGroup'>
+    | MakeActionCall<MultiEncryptWrapper, 'encryptFor1o1Async'>
+    | MakeActionCall<MultiEncryptWrapper, 'encryptForCommunityAsync'>
+    | MakeActionCall<MultiEncryptWrapper, 'encryptForGroupAsync'>
     | MakeActionCall<MultiEncryptWrapper, 'decryptForCommunity'>
     | MakeActionCall<MultiEncryptWrapper, 'decryptFor1o1'>
-    | MakeActionCall<MultiEncryptWrapper, 'decryptForGroup'>;
+    | MakeActionCall<MultiEncryptWrapper, 'decryptForGroup'>
+    | MakeActionCall<MultiEncryptWrapper, 'decryptFor1o1Async'>
+    | MakeActionCall<MultiEncryptWrapper, 'decryptForGroupAsync'>;
 }
@@ -20,7 +20,7 @@ declare module 'libsession_util_nodejs' {
 
   type AsyncWrapper<T extends (...args: any) => any> = (
     ...args: Parameters<T>
-  ) => Promise<ReturnType<T>>;
+  ) => Promise<Awaited<ReturnType<T>>>;
 
   export type RecordOfFunctions = Record<string, (...args: any) => any>;
 
@@ -45,8 +45,57 @@ declare module 'libsession_util_nodejs' {
   export type ConfirmPush = { seqno: number; hashes: Array<string> };
   export type MergeSingle = { hash: string; data: Uint8Array };
 
+  /** The keys of the entries of a collection added, updated and removed by a merge, sorted. */
+  export type ChangeSet = { added: Array<string>; updated: Array<string>; removed: Array<string> };
+  /**
+   * The change sets of a merge, by collection: `contact` for the contacts; `community`,
+   * `legacyGroup` and `group` for the user groups; `1o1`, `legacyGroup`, `group` and `community`
+   * for the convo volatile infos (communities are keyed by full url); `member` for the members of
+   * a group. Wrappers without collections (the user profile) have none.
+   */
+  export type ConfigChanges = Record<string, ChangeSet>;
+  export type MergeWithChanges = { merged: Array<string>; changes: ConfigChanges };
+
   type MakeActionCall<A extends RecordOfFunctions, B extends keyof A> = [B, ...Parameters<A[B]>];
 
+  /**
+   * A getter of all the `T`s of a wrapper, which can be given the only `fields` to return: the
+   * other fields are then not even converted from C++, which is cheaper for large lists.
+   */
+  type GetAllWithFields<T> = <F extends keyof T = keyof T>(fields?: Array<F>) => Array<Pick<T, F>>;
+
+  /**
+   * Returned by the `iterate` methods of the wrappers: iterates over one of their collections by
+   * batches, so that large ones don't have to be converted in a single call.
+   * Only usable on the thread of its wrapper, so not available through the actions.
+   */
+  export class ConfigCursorNode<T> {
+    private constructor();
+    /**
+     * The next (up to) `batchSize` entries, or an empty array once done.
+     * Throws if the wrapper was changed (set, erase, merge, push...) since the cursor was created.
+     */
+    public next: () => Array<T>;
+    /** Releases the cursor, and the wrapper it holds onto, before it is done. */
+    public close: () => void;
+  }
+
+  type IterateOptions<F extends PropertyKey> = {
+    /** How many entries `next()` returns at most. Defaults to 256. */
+    batchSize?: number;
+    /** Only convert those fields of the entries, like the `fields` of the `getAll` methods. */
+    fields?: Array<F>;
+  };
+
+  type Iterate<T> = <F extends keyof T = keyof T>(
+    options?: IterateOptions<F>
+  ) => ConfigCursorNode<Pick<T, F>>;
+
+  /** Iterates over one of the collections of `M` (mapping each `type` to its entries' type). */
+  type IterateByType<M> = <K extends keyof M, F extends keyof M[K] = keyof M[K]>(
+    options: IterateOptions<F> & { type: K }
+  ) => ConfigCursorNode<Pick<M[K], F>>;
+
   /**
    *
    * Base Config wrapper logic
@@ -60,7 +109,24 @@ declare module 'libsession_util_nodejs' {
     dump: () => Uint8Array;
     makeDump: () => Uint8Array;
     confirmPushed: (pushed: ConfirmPush) => void;
-    merge: (toMerge: Array<MergeSingle>) => Array<string>; // merge returns the array of hashes that merged correctly
+    /**
+     * Returns the array of hashes that merged correctly.
+     * With `{ changeSet: true }`, also returns what the merge changed (see `ConfigChanges`), which
+     * is much cheaper than fetching everything again to diff it.
+     */
+    merge: {
+      (toMerge: Array<MergeSingle>, options: { changeSet: true }): MergeWithChanges;
+      (toMerge: Array<MergeSingle>, options?: { changeSet?: boolean }): Array<string>;
+    };
+    /**
+     * Same as `merge`, but the merge itself runs on the libuv threadpool, as does computing the
+     * change set with `{ changeSet: true }`.
+     * While the returned promise is pending, any other call on this wrapper throws.
+     */
+    mergeAsync: {
+      (toMerge: Array<MergeSingle>, options: { changeSet: true }): Promise<MergeWithChanges>;
+      (toMerge: Array<MergeSingle>, options?: { changeSet?: boolean }): Promise<Array<string>>;
+    };
     storageNamespace: () => number;
     activeHashes: () => Array<string>;
   };
@@ -68,7 +134,7 @@ declare module 'libsession_util_nodejs' {
   export type GenericWrapperActionsCall<A extends string, B extends keyof BaseConfigWrapper> = (
     wrapperId: A,
     ...args: Parameters<BaseConfigWrapper[B]>
-  ) => Promise<ReturnType<BaseConfigWrapper[B]>>;
+  ) => Promise<Awaited<ReturnType<BaseConfigWrapper[B]>>>;
 
   export type BaseConfigActions =
     | MakeActionCall<BaseConfigWrapper, 'needsDump'>
@@ -78,6 +144,7 @@ declare module 'libsession_util_nodejs' {
     | MakeActionCall<BaseConfigWrapper, 'makeDump'>
     | MakeActionCall<BaseConfigWrapper, 'confirmPushed'>
     | MakeActionCall<BaseConfigWrapper, 'merge'>
+    | MakeActionCall<BaseConfigWrapper, 'mergeAsync'>
     | MakeActionCall<BaseConfigWrapper, 'storageNamespace'>
     | MakeActionCall<BaseConfigWrapper, 'activeHashes'>;
 
@@ -89,6 +156,7 @@ declare module 'libsession_util_nodejs' {
     public makeDump: BaseConfigWrapper['makeDump'];
     public confirmPushed: BaseConfigWrapper['confirmPushed'];
     public merge: BaseConfigWrapper['merge'];
+    public mergeAsync: BaseConfigWrapper['mergeAsync'];
     public storageNamespace: BaseConfigWrapper['storageNamespace'];
     public activeHashes: BaseConfigWrapper['activeHashes'];
   }
@@ -107,7 +175,7 @@ declare module 'libsession_util_nodejs' {
   type AsyncGroupWrapper<T extends (...args: any) => any> = (
     groupPk: GroupPubkeyType,
     ...args: Parameters<T>
-  ) => Promise<ReturnType<T>>;
+  ) => Promise<Awaited<ReturnType<T>>>;
 
   type MakeGroupWrapperActionCalls<Type extends RecordOfFunctions> = {
     [Property in keyof Omit<Type, 'initGroup'>]: AsyncGroupWrapper<Type[Property]>;
@@ -180,6 +248,11 @@ declare module 'libsession_util_nodejs' {
      * A string corresponding to the full hash of the commit
      */
     LIBSESSION_NODEJS_COMMIT: string;
+    /**
+     * The codes of the group member statuses, as in the `statuses` of `memberGetAllCompact`:
+     * `statuses[i] === CONSTANTS.MEMBER_STATUS.INVITE_SENT` is a member with an invite sent.
+     */
+    MEMBER_STATUS: Record<MemberStateGroupV2, number>;
     /** Object containing pro urls **/
     LIBSESSION_PRO_URLS: ProBackendUrlsType;
     /** Session Pro backend base URL (overridable prod/default) */
@@ -12,7 +12,12 @@ declare module 'libsession_util_nodejs' {
     free: () => void;
     get: (pubkeyHex: string) => ContactInfoGet | null;
     set: (contact: ContactInfoSet) => void;
-    getAll: () => Array<ContactInfoGet>;
+    getAll: GetAllWithFields<ContactInfoGet>;
+    /**
+     * Same data as `getAll`, but only the requested `fields`, one column per field rather than one
+     * object per contact. Much cheaper than `getAll` for large lists needing only a few fields.
+     */
+    getAllColumnar: <F extends ContactColumn>(fields: Array<F>) => ContactsColumnar<F>;
     erase: (pubkeyHex: string) => void;
   };
 
@@ -71,12 +76,50 @@ declare module 'libsession_util_nodejs' {
     proProfileBitset: bigint;
   };
 
+  export type ContactColumn = Exclude<keyof ContactInfoGet, 'profilePicture'>;
+
+  /**
+   * The columns of `getAllColumnar`: row `i` of each column is about the same contact.
+   */
+  export type ContactsColumnar<F extends ContactColumn = ContactColumn> = { count: number } & Pick<
+    {
+      /** The 33-byte session ids, packed: contact `i` is at `[i * 33, (i + 1) * 33)` */
+      id: Uint8Array;
+      name: Array<string | null>;
+      nickname: Array<string | null>;
+      /** Bitset: contact `i` is approved if `approved[i >> 3] & (1 << (i & 7))` */
+      approved: Uint8Array;
+      /** Bitset, see `approved` */
+      approvedMe: Uint8Array;
+      /** Bitset, see `approved` */
+      blocked: Uint8Array;
+      priority: Float64Array;
+      createdAtSeconds: Float64Array;
+      profileUpdatedSeconds: Float64Array;
+      /** 0: 'off', 1: 'deleteAfterRead', 2: 'deleteAfterSend' */
+      expirationMode: Uint8Array;
+      expirationTimerSeconds: Float64Array;
+      proProfileBitset: BigUint64Array;
+    },
+    F
+  >;
+
   export class ContactsConfigWrapperNode extends BaseConfigWrapperNode {
     constructor(secretKey: Uint8Array, dump: Uint8Array | null);
+    /**
+     * Same as the constructor, but the dump is loaded on the libuv threadpool, so that a large one
+     * does not block the calling thread.
+     */
+    public static createAsync(
+      secretKey: Uint8Array,
+      dump: Uint8Array | null
+    ): Promise<ContactsConfigWrapperNode>;
     public get: ContactsWrapper['get'];
     public set: ContactsWrapper['set'];
     public getAll: ContactsWrapper['getAll'];
+    public getAllColumnar: ContactsWrapper['getAllColumnar'];
     public erase: ContactsWrapper['erase'];
+    public iterate: Iterate<ContactInfoGet>;
   }
 
   export type ContactsConfigActionsType =
@@ -85,5 +128,6 @@ declare module 'libsession_util_nodejs' {
     | MakeActionCall<ContactsWrapper, 'get'>
     | MakeActionCall<ContactsWrapper, 'set'>
     | MakeActionCall<ContactsWrapper, 'getAll'>
+    | MakeActionCall<ContactsWrapper, 'getAllColumnar'>
     | MakeActionCall<ContactsWrapper, 'erase'>;
 }
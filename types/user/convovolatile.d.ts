@@ -40,25 +40,25 @@ declare module 'libsession_util_nodejs' {
 
     // 1o1 related methods
     get1o1: (pubkeyHex: string) => ConvoInfoVolatileGet1o1 | null;
-    getAll1o1: () => Array<ConvoInfoVolatileGet1o1>;
+    getAll1o1: GetAllWithFields<ConvoInfoVolatileGet1o1>;
     set1o1: (pubkeyHex: string, args: BaseConvoInfoVolatile & ConvoVolatile1o1SetExtra) => void;
     erase1o1: (pubkeyHex: string) => void;
 
     // legacy group related methods
     getLegacyGroup: (pubkeyHex: string) => ConvoInfoVolatileGetLegacyGroup | null;
-    getAllLegacyGroups: () => Array<ConvoInfoVolatileGetLegacyGroup>;
+    getAllLegacyGroups: GetAllWithFields<ConvoInfoVolatileGetLegacyGroup>;
     setLegacyGroup: (pubkeyHex: string, args: BaseConvoInfoVolatile) => void;
     eraseLegacyGroup: (pubkeyHex: string) => boolean;
 
     // group related methods
     getGroup: (pubkeyHex: GroupPubkeyType) => ConvoInfoVolatileGetGroup | null;
-    getAllGroups: () => Array<ConvoInfoVolatileGetGroup>;
+    getAllGroups: GetAllWithFields<ConvoInfoVolatileGetGroup>;
     setGroup: (pubkeyHex: GroupPubkeyType, args: BaseConvoInfoVolatile) => void;
     eraseGroup: (pubkeyHex: GroupPubkeyType) => boolean;
 
     // communities related methods
     getCommunity: (communityFullUrl: string) => ConvoInfoVolatileGetCommunity | null; // pubkey not required
-    getAllCommunities: () => Array<ConvoInfoVolatileGetCommunity>;
+    getAllCommunities: GetAllWithFields<ConvoInfoVolatileGetCommunity>;
     setCommunityByFullUrl: (fullUrlWithPubkey: string, args: BaseConvoInfoVolatile) => void;
     eraseCommunityByFullUrl: (fullUrlWithOrWithoutPubkey: string) => void;
   };
@@ -68,6 +68,14 @@ declare module 'libsession_util_nodejs' {
 
   export class ConvoInfoVolatileWrapperNode extends BaseConfigWrapperNode {
     constructor(secretKey: Uint8Array, dump: Uint8Array | null);
+    /**
+     * Same as the constructor, but the dump is loaded on the libuv threadpool, so that a large one
+     * does not block the calling thread.
+     */
+    public static createAsync(
+      secretKey: Uint8Array,
+      dump: Uint8Array | null
+    ): Promise<ConvoInfoVolatileWrapperNode>;
     // 1o1 related methods
     public get1o1: ConvoInfoVolatileWrapper['get1o1'];
     public getAll1o1: ConvoInfoVolatileWrapper['getAll1o1'];
@@ -85,6 +93,13 @@ declare module 'libsession_util_nodejs' {
     public setCommunityByFullUrl: ConvoInfoVolatileWrapper['setCommunityByFullUrl'];
     public getAllCommunities: ConvoInfoVolatileWrapper['getAllCommunities'];
     public eraseCommunityByFullUrl: ConvoInfoVolatileWrapper['eraseCommunityByFullUrl'];
+
+    public iterate: IterateByType<{
+      '1o1': ConvoInfoVolatileGet1o1;
+      legacyGroup: ConvoInfoVolatileGetLegacyGroup;
+      group: ConvoInfoVolatileGetGroup;
+      community: ConvoInfoVolatileGetCommunity;
+    }>;
   }
 
   export type ConvoInfoVolatileConfigActionsType =
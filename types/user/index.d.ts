@@ -2,3 +2,4 @@
 /// <reference path="./contacts.d.ts" />
 /// <reference path="./convovolatile.d.ts" />
 /// <reference path="./usergroups.d.ts" />
+/// <reference path="./metauser.d.ts" />
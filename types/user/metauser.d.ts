@@ -0,0 +1,88 @@
+/// <reference path="../shared.d.ts" />
+/// <reference path="./userconfig.d.ts" />
+/// <reference path="./contacts.d.ts" />
+/// <reference path="./convovolatile.d.ts" />
+/// <reference path="./usergroups.d.ts" />
+
+declare module 'libsession_util_nodejs' {
+  /**
+   *
+   * MetaUser wrapper logic: the four user configs, loaded from one combined dump and pushed, dumped
+   * and merged in one call each.
+   *
+   */
+  type UserConfigsRecord<T> = {
+    contacts: T;
+    convoInfoVolatile: T;
+    userGroups: T;
+    userProfile: T;
+  };
+
+  export type MetaUserMergeArgs = Partial<UserConfigsRecord<Array<MergeSingle> | null>>;
+
+  type MetaUserWrapper = {
+    init: (secretKey: Uint8Array, metaDumped: Uint8Array | null) => void;
+    /** This function is used to free wrappers from memory only */
+    free: () => void;
+    needsPush: () => boolean;
+    /** Each config is null if it does not need pushing. */
+    push: () => UserConfigsRecord<PushConfigResult | null>;
+    needsDump: () => boolean;
+    /** The dumps of the four configs, combined: what to save, and to give to the constructor. */
+    metaDump: () => Uint8Array;
+    metaMakeDump: () => Uint8Array;
+    metaConfirmPushed: (pushed: Partial<UserConfigsRecord<ConfirmPush | null>>) => void;
+    /**
+     * Merges the messages of each config into it. Nothing is merged if any argument is invalid.
+     * @returns the hashes that merged correctly, per config
+     */
+    metaMerge: (toMerge: MetaUserMergeArgs) => UserConfigsRecord<Array<string>>;
+  };
+
+  export type MetaUserWrapperActionsCalls = MakeWrapperActionCalls<MetaUserWrapper>;
+
+  /**
+   * To be used inside the web worker only (calls are synchronous and won't work asynchronously)
+   */
+  export class MetaUserWrapperNode {
+    /**
+     * @param metaDumped the combined dump returned by `metaDump`, or null for a new user. A config
+     * missing from it starts empty.
+     */
+    constructor(secretKey: Uint8Array, metaDumped: Uint8Array | null);
+    /** Same as the constructor, but the configs are loaded on the libuv threadpool. */
+    public static createAsync(
+      secretKey: Uint8Array,
+      metaDumped: Uint8Array | null
+    ): Promise<MetaUserWrapperNode>;
+
+    /**
+     * The wrappers of the four configs, to use them individually. They share their state with
+     * this object: a change made through either is seen by the other.
+     */
+    public configs: () => {
+      contacts: ContactsConfigWrapperNode;
+      convoInfoVolatile: ConvoInfoVolatileWrapperNode;
+      userGroups: UserGroupsWrapperNode;
+      userProfile: UserConfigWrapperNode;
+    };
+    public needsPush: MetaUserWrapper['needsPush'];
+    public push: MetaUserWrapper['push'];
+    public needsDump: MetaUserWrapper['needsDump'];
+    public metaDump: MetaUserWrapper['metaDump'];
+    public metaMakeDump: MetaUserWrapper['metaMakeDump'];
+    public metaConfirmPushed: MetaUserWrapper['metaConfirmPushed'];
+    public metaMerge: MetaUserWrapper['metaMerge'];
+  }
+
+  export type MetaUserActionsType =
+    | ['init', Uint8Array, Uint8Array | null]
+    | MakeActionCall<MetaUserWrapper, 'free'>
+    | MakeActionCall<MetaUserWrapper, 'needsPush'>
+    | MakeActionCall<MetaUserWrapper, 'push'>
+    | MakeActionCall<MetaUserWrapper, 'needsDump'>
+    | MakeActionCall<MetaUserWrapper, 'metaDump'>
+    | MakeActionCall<MetaUserWrapper, 'metaMakeDump'>
+    | MakeActionCall<MetaUserWrapper, 'metaConfirmPushed'>
+    | MakeActionCall<MetaUserWrapper, 'metaMerge'>;
+}
@@ -107,6 +107,14 @@ declare module 'libsession_util_nodejs' {
    */
   export class UserConfigWrapperNode extends BaseConfigWrapperNode {
     constructor(secretKey: Uint8Array, dump: Uint8Array | null);
+    /**
+     * Same as the constructor, but the dump is loaded on the libuv threadpool, so that a large one
+     * does not block the calling thread.
+     */
+    public static createAsync(
+      secretKey: Uint8Array,
+      dump: Uint8Array | null
+    ): Promise<UserConfigWrapperNode>;
     public getPriority: UserConfigWrapper['getPriority'];
     public getName: UserConfigWrapper['getName'];
     public getProfilePic: UserConfigWrapper['getProfilePic'];
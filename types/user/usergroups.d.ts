@@ -92,7 +92,7 @@ declare module 'libsession_util_nodejs' {
      * Note: this needs the pubkey to be provided in the argument as it might need to create it.
      */
     setCommunityByFullUrl: (fullUrlWithPubkey: string, priority: number) => null;
-    getAllCommunities: () => Array<CommunityInfo>;
+    getAllCommunities: GetAllWithFields<CommunityInfo>;
 
     /**
      * Note: can have the pubkey argument set or not.
@@ -102,7 +102,7 @@ declare module 'libsession_util_nodejs' {
 
     // Legacy groups related methods
     getLegacyGroup: (pubkeyHex: string) => LegacyGroupInfo | null;
-    getAllLegacyGroups: () => Array<LegacyGroupInfo>;
+    getAllLegacyGroups: GetAllWithFields<LegacyGroupInfo>;
     setLegacyGroup: (info: LegacyGroupInfo) => boolean;
     eraseLegacyGroup: (pubkeyHex: string) => boolean;
 
@@ -110,7 +110,7 @@ declare module 'libsession_util_nodejs' {
     // the create group always returns the secretKey as we've just created it
     createGroup: () => UserGroupsGet & NonNullable<Pick<UserGroupsGet, 'secretKey'>>;
     getGroup: (pubkeyHex: GroupPubkeyType) => UserGroupsGet | null;
-    getAllGroups: () => Array<UserGroupsGet>;
+    getAllGroups: GetAllWithFields<UserGroupsGet>;
     setGroup: (info: UserGroupsSet) => UserGroupsGet;
     markGroupKicked: (pubkeyHex: GroupPubkeyType) => UserGroupsGet;
     markGroupInvited: (pubkeyHex: GroupPubkeyType) => UserGroupsGet;
@@ -122,6 +122,14 @@ declare module 'libsession_util_nodejs' {
 
   export class UserGroupsWrapperNode extends BaseConfigWrapperNode {
     constructor(secretKey: Uint8Array, dump: Uint8Array | null);
+    /**
+     * Same as the constructor, but the dump is loaded on the libuv threadpool, so that a large one
+     * does not block the calling thread.
+     */
+    public static createAsync(
+      secretKey: Uint8Array,
+      dump: Uint8Array | null
+    ): Promise<UserGroupsWrapperNode>;
     // communities related methods
     public getCommunityByFullUrl: UserGroupsWrapper['getCommunityByFullUrl'];
     public setCommunityByFullUrl: UserGroupsWrapper['setCommunityByFullUrl'];
@@ -144,6 +152,12 @@ declare module 'libsession_util_nodejs' {
     public markGroupInvited: UserGroupsWrapper['markGroupInvited'];
     public markGroupDestroyed: UserGroupsWrapper['markGroupDestroyed'];
     public eraseGroup: UserGroupsWrapper['eraseGroup'];
+
+    public iterate: IterateByType<{
+      community: CommunityInfo;
+      legacyGroup: LegacyGroupInfo;
+      group: UserGroupsGet;
+    }>;
   }
 
   export type UserGroupsConfigActionsType =